@@ -15,20 +15,45 @@ echo ==========================================
 
 echo Compiling models...
 g++ -std=c++17 -c src/models/TodoItem.cpp -I. -o TodoItem.o
+g++ -std=c++17 -c src/models/TodoItemView.cpp -I. -o TodoItemView.o
 g++ -std=c++17 -c src/models/PriorityQueue.cpp -I. -o PriorityQueue.o
+g++ -std=c++17 -c src/models/IdIndex.cpp -I. -o IdIndex.o
+g++ -std=c++17 -c src/models/SlotMap.cpp -I. -o SlotMap.o
+g++ -std=c++17 -c src/models/RoaringBitmap.cpp -I. -o RoaringBitmap.o
+g++ -std=c++17 -c src/models/DueDateIndex.cpp -I. -o DueDateIndex.o
+g++ -std=c++17 -c src/models/Aggregates.cpp -I. -o Aggregates.o
+g++ -std=c++17 -c src/models/TextIndex.cpp -I. -o TextIndex.o
+g++ -std=c++17 -c src/models/TrigramIndex.cpp -I. -o TrigramIndex.o
+g++ -std=c++17 -c src/models/TitleTrie.cpp -I. -o TitleTrie.o
+g++ -std=c++17 -c src/models/BucketQueue.cpp -I. -o BucketQueue.o
+g++ -std=c++17 -c src/models/TopKCache.cpp -I. -o TopKCache.o
+g++ -std=c++17 -c src/models/Query.cpp -I. -o Query.o
 
 echo Compiling utils...
 g++ -std=c++17 -c src/utils/ColorManager.cpp -I. -o ColorManager.o
 g++ -std=c++17 -c src/utils/FileHandler.cpp -I. -o FileHandler.o
+g++ -std=c++17 -c src/utils/Journal.cpp -I. -o Journal.o
+g++ -std=c++17 -c src/utils/GroupCommit.cpp -I. -o GroupCommit.o
+g++ -std=c++17 -c src/utils/MappedStore.cpp -I. -o MappedStore.o
+g++ -std=c++17 -c src/utils/BackupCatalog.cpp -I. -o BackupCatalog.o
+g++ -std=c++17 -c src/utils/BlockCodec.cpp -I. -o BlockCodec.o
+g++ -std=c++17 -c src/utils/BlockFile.cpp -I. -o BlockFile.o
+g++ -std=c++17 -c src/utils/BufferedFile.cpp -I. -o BufferedFile.o
+g++ -std=c++17 -c src/utils/CsvWriter.cpp -I. -o CsvWriter.o
+g++ -std=c++17 -c src/utils/JsonWriter.cpp -I. -o JsonWriter.o
+g++ -std=c++17 -c src/utils/ThreadPool.cpp -I. -o ThreadPool.o
+g++ -std=c++17 -c src/utils/Importer.cpp -I. -o Importer.o
 
 echo Compiling controllers...
 g++ -std=c++17 -c src/controllers/TodoController.cpp -I. -o TodoController.o
+g++ -std=c++17 -c src/controllers/QueryCursor.cpp -I. -o QueryCursor.o
 
 echo Compiling views...
 g++ -std=c++17 -c src/views/DisplayManager.cpp -I. -o DisplayManager.o
 
 echo Compiling algorithms...
 g++ -std=c++17 -c src/algorithms/SortSearch.cpp -I. -o SortSearch.o
+g++ -std=c++17 -c src/algorithms/SubstringSearch.cpp -I. -o SubstringSearch.o
 
 echo Compiling tests...
 g++ -std=c++17 -c tests/TestDataGenerator.cpp -I. -o TestDataGenerator.o
@@ -39,15 +64,40 @@ g++ -std=c++17 -c main.cpp -I. -o main.o
 echo.
 echo Step 2: Linking all object files...
 echo ==========================================
-g++ -std=c++17 -o TodoApp.exe ^
+g++ -std=c++17 -pthread -o TodoApp.exe ^
     main.o ^
     TodoItem.o ^
+    TodoItemView.o ^
     PriorityQueue.o ^
+    IdIndex.o ^
+    SlotMap.o ^
+    RoaringBitmap.o ^
+    DueDateIndex.o ^
+    Aggregates.o ^
+    TextIndex.o ^
+    TrigramIndex.o ^
+    TitleTrie.o ^
+    BucketQueue.o ^
+    TopKCache.o ^
+    Query.o ^
     ColorManager.o ^
     FileHandler.o ^
+    Journal.o ^
+    GroupCommit.o ^
+    MappedStore.o ^
+    BackupCatalog.o ^
+    BlockCodec.o ^
+    BlockFile.o ^
+    BufferedFile.o ^
+    CsvWriter.o ^
+    JsonWriter.o ^
+    ThreadPool.o ^
+    Importer.o ^
     TodoController.o ^
+    QueryCursor.o ^
     DisplayManager.o ^
     SortSearch.o ^
+    SubstringSearch.o ^
     TestDataGenerator.o
 
 if %errorlevel% equ 0 (
@@ -79,7 +129,20 @@ if %errorlevel% equ 0 (
         main.cpp ^
         src/models/TodoItem.cpp ^
         src/models/PriorityQueue.cpp ^
+        src/models/IdIndex.cpp ^
+        src/models/SlotMap.cpp ^
+        src/models/RoaringBitmap.cpp ^
+        src/models/DueDateIndex.cpp ^
+        src/models/Aggregates.cpp ^
+        src/models/TextIndex.cpp ^
+        src/models/TrigramIndex.cpp ^
+        src/models/TitleTrie.cpp ^
+        src/models/BucketQueue.cpp ^
+        src/models/TopKCache.cpp ^
+        src/models/Query.cpp ^
         src/controllers/TodoController.cpp ^
+        src/controllers/QueryCursor.cpp ^
+        src/algorithms/SubstringSearch.cpp ^
         src/views/DisplayManager.cpp ^
         src/utils/ColorManager.cpp ^
         -I.
@@ -38,26 +38,107 @@ void runApplication()
         case 3:
         {
             // Search todo
-            std::cout << "\nAvailable Todo IDs: ";
-            auto todos = controller.getAllTodos();
-            for (const auto &t : todos)
+            std::cout << "\n1. Search by ID\n";
+            std::cout << "2. Due between two dates\n";
+            std::cout << "3. Overdue\n";
+            std::cout << "4. Next due\n";
+            std::cout << "5. Query (e.g. status!=completed priority>=high order by due limit 20)\n";
+            std::cout << "6. Keywords in title or description\n";
+            std::cout << "7. Title contains (any case)\n";
+            std::cout << "8. Title starts with (suggestions)\n";
+            std::cout << "9. Most urgent open tasks\n";
+            int searchChoice = display.getIntInput("Choose search (1-9): ");
+
+            switch (searchChoice)
             {
-                std::cout << t.id << " ";
-            }
-            std::cout << std::endl;
+            case 1:
+            {
+                std::cout << "\nAvailable Todo IDs: ";
+                auto todos = controller.getAllTodos();
+                for (const auto &t : todos)
+                {
+                    std::cout << t.id << " ";
+                }
+                std::cout << std::endl;
 
-            int id = display.getIntInput("Enter ID to search: ");
-            TodoItem *found = controller.searchById(id);
+                int id = display.getIntInput("Enter ID to search: ");
+                TodoItem *found = controller.searchById(id);
 
-            if (found != nullptr)
+                if (found != nullptr)
+                {
+                    std::cout << ColorManager::GREEN << "Found Todo ID " << id << "!\n"
+                              << ColorManager::RESET;
+                    display.printTodoCard(*found);
+                }
+                else
+                {
+                    std::cout << ColorManager::RED << "Todo not found!\n"
+                              << ColorManager::RESET;
+                }
+                break;
+            }
+            case 2:
             {
-                std::cout << ColorManager::GREEN << "Found Todo ID " << id << "!\n"
+                std::cout << "From date:\n";
+                std::string from = display.getDateInput();
+                std::cout << "To date:\n";
+                std::string to = display.getDateInput();
+                display.showSearchResults(controller.searchByDueRange(from, to));
+                break;
+            }
+            case 3:
+                display.showSearchResults(controller.searchOverdue());
+                break;
+            case 4:
+            {
+                int count = display.getIntInput("How many: ");
+                display.showSearchResults(controller.nextDue(count > 0 ? count : 10));
+                break;
+            }
+            case 5:
+            {
+                Query query;
+                std::string error;
+                if (!Query::parse(display.getInput("Query: "), query, error))
+                {
+                    std::cout << ColorManager::RED << "Invalid query: " << error << "\n"
+                              << ColorManager::RESET;
+                    break;
+                }
+                QueryCursor cursor = controller.openQuery(query);
+                std::vector<TodoHandle> results = cursor.next();
+                std::cout << ColorManager::CYAN << "Plan: " << cursor.explain() << " ("
+                          << cursor.rowsExamined() << " rows examined)\n"
                           << ColorManager::RESET;
-                display.printTodoCard(*found);
+                display.showSearchResults(results);
+                break;
             }
-            else
+            case 6:
             {
-                std::cout << ColorManager::RED << "Todo not found!\n"
+                std::string words = display.getInput("Keywords (OR between alternatives, \"...\" for a phrase): ");
+                display.showSearchResults(controller.searchText(words));
+                break;
+            }
+            case 7:
+            {
+                std::string text = display.getInput("Title contains: ");
+                display.showSearchResults(controller.searchByTitle(text, true));
+                break;
+            }
+            case 8:
+            {
+                std::string prefix = display.getInput("Title starts with: ");
+                display.showSearchResults(controller.completeTitle(prefix));
+                break;
+            }
+            case 9:
+            {
+                int count = display.getIntInput("How many: ");
+                display.showSearchResults(controller.nextTasks(count > 0 ? count : 10));
+                break;
+            }
+            default:
+                std::cout << ColorManager::RED << "Invalid choice!\n"
                           << ColorManager::RESET;
             }
             break;
@@ -241,24 +322,24 @@ void runApplication()
         case 6:
         {
             // Sort todos
-            std::cout << "\n1. Sort by Priority (Quick Sort)\n";
-            std::cout << "2. Sort by Due Date (Merge Sort)\n";
-            std::cout << "3. Sort by Status (Bubble Sort)\n";
+            std::cout << "\n1. Sort by Priority (Counting Sort)\n";
+            std::cout << "2. Sort by Due Date (Due Index)\n";
+            std::cout << "3. Sort by Status (Counting Sort)\n";
             int sortChoice = display.getIntInput("Choose sorting method: ");
 
             switch (sortChoice)
             {
             case 1:
                 controller.sortByPriority();
-                std::cout << "Sorted by priority using Quick Sort!\n";
+                std::cout << "Sorted by priority using Counting Sort!\n";
                 break;
             case 2:
                 controller.sortByDueDate();
-                std::cout << "Sorted by due date using Merge Sort!\n";
+                std::cout << "Sorted by due date using the due index!\n";
                 break;
             case 3:
                 controller.sortByStatus();
-                std::cout << "Sorted by status using Bubble Sort!\n";
+                std::cout << "Sorted by status using Counting Sort!\n";
                 break;
             }
 
@@ -281,22 +362,37 @@ void runApplication()
             std::cout << "╚══════════════════════════════════════════════════════╝\n";
             std::cout << ColorManager::RESET;
 
-            std::cout << "\n1. Create Backup (Binary + CSV)\n";
+            std::cout << "\n1. Create Backup (Full / Incremental / Differential)\n";
             std::cout << "2. Export to CSV\n";
             std::cout << "3. Export to JSON\n";
-            std::cout << "4. Restore from Backup\n";
-            std::cout << "5. Show File Statistics\n";
+            std::cout << "4. Export to NDJSON (one todo per line)\n";
+            std::cout << "5. Restore from Backup\n";
+            std::cout << "6. Show File Statistics\n";
+            std::cout << "7. Toggle Compression (currently "
+                      << (controller.isCompressionEnabled() ? "ON" : "OFF") << ")\n";
+            std::cout << "8. Import from CSV / JSON / NDJSON\n";
 
-            int fileChoice = display.getIntInput("Choose file operation (1-5): ");
+            int fileChoice = display.getIntInput("Choose file operation (1-8): ");
 
             switch (fileChoice)
             {
             case 1:
-                if (controller.createBackup())
+            {
+                std::cout << "\n1. Auto (full, then incremental)\n";
+                std::cout << "2. Full\n";
+                std::cout << "3. Incremental (changes since last backup)\n";
+                std::cout << "4. Differential (changes since last full backup)\n";
+                int kindChoice = display.getIntInput("Choose backup type (1-4): ");
+                BackupKind kind = kindChoice == 2   ? BackupKind::FULL
+                                  : kindChoice == 3 ? BackupKind::INCREMENTAL
+                                  : kindChoice == 4 ? BackupKind::DIFFERENTIAL
+                                                    : BackupKind::AUTO;
+
+                if (controller.createBackup(kind))
                 {
                     std::cout << ColorManager::GREEN << "\n✅ Backup created successfully!\n"
                               << ColorManager::RESET;
-                    std::cout << "Files saved in 'backup/' and 'exports/' directories\n";
+                    std::cout << "Files saved in 'backup/' directory\n";
                 }
                 else
                 {
@@ -304,6 +400,7 @@ void runApplication()
                               << ColorManager::RESET;
                 }
                 break;
+            }
 
             case 2:
                 if (controller.exportToCSV())
@@ -334,11 +431,25 @@ void runApplication()
                 break;
 
             case 4:
+                if (controller.exportToNDJSON())
+                {
+                    std::cout << ColorManager::GREEN << "\n✅ NDJSON export successful!\n"
+                              << ColorManager::RESET;
+                    std::cout << "File saved in 'exports/' directory\n";
+                }
+                else
+                {
+                    std::cout << ColorManager::RED << "\n❌ NDJSON export failed!\n"
+                              << ColorManager::RESET;
+                }
+                break;
+
+            case 5:
                 if (controller.restoreFromBackup())
                 {
                     std::cout << ColorManager::GREEN << "\n✅ Restore completed successfully!\n"
                               << ColorManager::RESET;
-                    std::cout << "Please restart the application to load restored data\n";
+                    std::cout << "Restored data is now loaded\n";
                 }
                 else
                 {
@@ -347,10 +458,35 @@ void runApplication()
                 }
                 break;
 
-            case 5:
+            case 6:
                 controller.showFileStats();
                 break;
 
+            case 7:
+                controller.setCompression(!controller.isCompressionEnabled());
+                std::cout << ColorManager::GREEN << "\n✅ Compression "
+                          << (controller.isCompressionEnabled() ? "enabled" : "disabled")
+                          << ColorManager::RESET << "\n";
+                std::cout << "Applies to the next save and backup\n";
+                break;
+
+            case 8:
+            {
+                std::string path = display.getInput("Enter file to import (e.g. exports/todos_export.csv): ");
+                size_t imported = controller.importFile(path);
+                if (imported > 0)
+                {
+                    std::cout << ColorManager::GREEN << "\n✅ Imported " << imported << " todos!\n"
+                              << ColorManager::RESET;
+                }
+                else
+                {
+                    std::cout << ColorManager::RED << "\n❌ Nothing was imported\n"
+                              << ColorManager::RESET;
+                }
+                break;
+            }
+
             default:
                 std::cout << ColorManager::RED << "Invalid choice!\n"
                           << ColorManager::RESET;
@@ -1,6 +1,9 @@
 #include "SortSearch.h"
+#include "../models/DueDateIndex.h"
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <memory>
 
 // Linear Search - O(n)
 int SortSearch::linearSearch(const std::vector<TodoItem>& items, int id) {
@@ -157,6 +160,323 @@ void SortSearch::bubbleSort(std::vector<TodoItem>& items) {
     }
 }
 
+namespace {
+
+// Ranges up to this long are sorted by one thread
+constexpr size_t PARALLEL_CUTOFF = 1 << 14;
+// The parallel merge sort insertion sorts runs this short
+constexpr size_t INSERTION_RUN = 24;
+
+// Chunks for one pass over n items: a few per thread, none much shorter
+// than the cutoff
+size_t chunkCount(const ThreadPool& pool, size_t n) {
+    return std::max<size_t>(1, std::min(4 * (pool.size() + 1), n / PARALLEL_CUTOFF));
+}
+
+// body(chunk, from, to) for parts even slices of [0, n), across the pool
+template <typename Body>
+void forChunks(ThreadPool& pool, size_t n, size_t parts, const Body& body) {
+    pool.parallelFor(parts, [&](size_t c) { body(c, n * c / parts, n * (c + 1) / parts); });
+}
+
+void parallelMove(TodoItem* from, size_t n, TodoItem* to, ThreadPool& pool) {
+    forChunks(pool, n, chunkCount(pool, n), [&](size_t, size_t begin, size_t end) {
+        std::move(from + begin, from + end, to + begin);
+    });
+}
+
+// The one buffer a parallel sort moves items through. Building and
+// destroying tens of millions of TodoItems takes a while, so both are
+// spread over the pool too
+class ScratchBuffer {
+public:
+    ScratchBuffer(size_t n, ThreadPool& pool)
+        : n(n), pool(pool), items(std::allocator<TodoItem>().allocate(n)) {
+        forChunks(pool, n, chunkCount(pool, n), [this](size_t, size_t from, size_t to) {
+            std::uninitialized_default_construct(items + from, items + to);
+        });
+    }
+    ~ScratchBuffer() {
+        forChunks(pool, n, chunkCount(pool, n), [this](size_t, size_t from, size_t to) {
+            std::destroy(items + from, items + to);
+        });
+        std::allocator<TodoItem>().deallocate(items, n);
+    }
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    TodoItem* data() { return items; }
+
+private:
+    size_t n;
+    ThreadPool& pool;
+    TodoItem* items;
+};
+
+template <typename Less>
+void insertionSort(TodoItem* first, TodoItem* last, const Less& less) {
+    if (first == last) return;
+    for (TodoItem* i = first + 1; i < last; i++) {
+        if (!less(*i, *(i - 1))) continue;
+        TodoItem item = std::move(*i);
+        TodoItem* j = i;
+        do {
+            *j = std::move(*(j - 1));
+            j--;
+        } while (j > first && less(item, *(j - 1)));
+        *j = std::move(item);
+    }
+}
+
+// Co-rank: how many of the first i items of the stable merge of a and b
+// come from a (ties take a first). Binary search, O(log min(na, nb))
+template <typename Less>
+size_t coRank(size_t i, const TodoItem* a, size_t na, const TodoItem* b, size_t nb, const Less& less) {
+    size_t low = i > nb ? i - nb : 0;
+    size_t high = std::min(i, na);
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        size_t k = i - mid;
+        if (k == 0 || less(b[k - 1], a[mid])) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+// Merge a and b into out, stable. The output is cut into even slices and
+// co-ranking finds where each slice starts in a and b, so the slices merge
+// independently. The ranks are all found before any item moves out
+template <typename Less>
+void parallelMerge(TodoItem* a, size_t na, TodoItem* b, size_t nb, TodoItem* out,
+                   const Less& less, ThreadPool& pool) {
+    size_t n = na + nb;
+    size_t parts = chunkCount(pool, n);
+    std::vector<size_t> ranks(parts + 1);
+    for (size_t c = 0; c <= parts; c++) {
+        ranks[c] = coRank(n * c / parts, a, na, b, nb, less);
+    }
+    forChunks(pool, n, parts, [&](size_t c, size_t from, size_t to) {
+        size_t aFrom = ranks[c];
+        size_t aTo = ranks[c + 1];
+        std::merge(std::make_move_iterator(a + aFrom), std::make_move_iterator(a + aTo),
+                   std::make_move_iterator(b + (from - aFrom)), std::make_move_iterator(b + (to - aTo)),
+                   out + from, less);
+    });
+}
+
+// Sort src[0, n), leaving the result in dst if intoDst and in src if not.
+// Each half is sorted into the other buffer and merged back, so a level
+// moves every item once. Runs of at most leafSize go to leaf, in place;
+// above the cutoff the halves are separate tasks and the merge is shared
+template <typename Less, typename Leaf>
+void mergeSortTask(TodoItem* src, TodoItem* dst, size_t n, bool intoDst,
+                   const Less& less, const Leaf& leaf, size_t leafSize, ThreadPool& pool) {
+    if (n <= leafSize) {
+        leaf(src, src + n);
+        if (intoDst) std::move(src, src + n, dst);
+        return;
+    }
+    size_t half = n / 2;
+    auto sortHalf = [&](size_t side) {
+        size_t offset = side == 0 ? 0 : half;
+        size_t length = side == 0 ? half : n - half;
+        mergeSortTask(src + offset, dst + offset, length, !intoDst, less, leaf, leafSize, pool);
+    };
+    TodoItem* from = intoDst ? src : dst;
+    TodoItem* to = intoDst ? dst : src;
+    if (n <= PARALLEL_CUTOFF) {
+        sortHalf(0);
+        sortHalf(1);
+        std::merge(std::make_move_iterator(from), std::make_move_iterator(from + half),
+                   std::make_move_iterator(from + half), std::make_move_iterator(from + n), to, less);
+        return;
+    }
+    pool.parallelFor(2, sortHalf);
+    parallelMerge(from, half, from + half, n - half, to, less, pool);
+}
+
+template <typename Less>
+const TodoItem& medianOf3(const TodoItem& a, const TodoItem& b, const TodoItem& c, const Less& less) {
+    if (less(a, b)) return less(b, c) ? b : (less(a, c) ? c : a);
+    return less(a, c) ? a : (less(b, c) ? c : b);
+}
+
+// Sort src[0, n) into dst (intoDst) or src. Chunks of the range count
+// their items below, equal to and above a pivot, then scatter them into
+// the other buffer; the equal block is in place, and the two sides
+// recurse as separate tasks. Three ways, so the few distinct priorities
+// end the recursion after a couple of levels
+template <typename Less>
+void quickSortTask(TodoItem* src, TodoItem* dst, size_t n, bool intoDst, const Less& less, ThreadPool& pool) {
+    if (n <= PARALLEL_CUTOFF) {
+        std::sort(src, src + n, less);
+        if (intoDst) std::move(src, src + n, dst);
+        return;
+    }
+    
+    size_t step = n / 8;
+    const TodoItem pivot = medianOf3(medianOf3(src[0], src[step], src[2 * step], less),
+                                     medianOf3(src[3 * step], src[4 * step], src[5 * step], less),
+                                     medianOf3(src[6 * step], src[7 * step], src[n - 1], less), less);
+    
+    struct Counts {
+        size_t below = 0;
+        size_t equal = 0;
+        size_t above = 0;
+    };
+    size_t chunks = chunkCount(pool, n);
+    std::vector<Counts> counts(chunks);
+    forChunks(pool, n, chunks, [&](size_t c, size_t from, size_t to) {
+        Counts count;
+        for (size_t i = from; i < to; i++) {
+            if (less(src[i], pivot)) {
+                count.below++;
+            } else if (less(pivot, src[i])) {
+                count.above++;
+            } else {
+                count.equal++;
+            }
+        }
+        counts[c] = count;
+    });
+    
+    // Where each chunk's items of each kind start in dst
+    Counts total;
+    for (Counts& count : counts) {
+        Counts here = count;
+        count = total;
+        total.below += here.below;
+        total.equal += here.equal;
+        total.above += here.above;
+    }
+    for (Counts& start : counts) {
+        start.equal += total.below;
+        start.above += total.below + total.equal;
+    }
+    forChunks(pool, n, chunks, [&](size_t c, size_t from, size_t to) {
+        Counts at = counts[c];
+        for (size_t i = from; i < to; i++) {
+            if (less(src[i], pivot)) {
+                dst[at.below++] = std::move(src[i]);
+            } else if (less(pivot, src[i])) {
+                dst[at.above++] = std::move(src[i]);
+            } else {
+                dst[at.equal++] = std::move(src[i]);
+            }
+        }
+    });
+    
+    size_t aboveStart = total.below + total.equal;
+    if (!intoDst) parallelMove(dst + total.below, total.equal, src + total.below, pool);
+    pool.parallelFor(2, [&](size_t side) {
+        if (side == 0) {
+            quickSortTask(dst, src, total.below, !intoDst, less, pool);
+        } else {
+            quickSortTask(dst + aboveStart, src + aboveStart, total.above, !intoDst, less, pool);
+        }
+    });
+}
+
+} // namespace
+
+// Parallel Quick Sort - O(n log n) work, partitions shared between threads.
+// Leaves use std::sort: the Lomuto quickSort above is quadratic on runs of
+// equal priorities
+void SortSearch::parallelQuickSort(std::vector<TodoItem>& items, ThreadPool& pool) {
+    auto less = [](const TodoItem& a, const TodoItem& b) { return compareByPriority(a, b); };
+    if (items.size() <= PARALLEL_CUTOFF) {
+        std::sort(items.begin(), items.end(), less);
+        return;
+    }
+    ScratchBuffer scratch(items.size(), pool);
+    quickSortTask(items.data(), scratch.data(), items.size(), false, less, pool);
+}
+
+// Parallel Merge Sort - O(n log n), stable
+void SortSearch::parallelMergeSort(std::vector<TodoItem>& items, ThreadPool& pool) {
+    auto less = [](const TodoItem& a, const TodoItem& b) { return compareByDueDate(a, b); };
+    auto leaf = [&less](TodoItem* first, TodoItem* last) { insertionSort(first, last, less); };
+    if (items.size() <= INSERTION_RUN) {
+        leaf(items.data(), items.data() + items.size());
+        return;
+    }
+    ScratchBuffer scratch(items.size(), pool);
+    mergeSortTask(items.data(), scratch.data(), items.size(), false, less, leaf, INSERTION_RUN, pool);
+}
+
+// Parallel Heap Sort - O(n log n). A heap sort is one sequential loop, so
+// cutoff-sized runs are heap sorted in parallel and then merged
+void SortSearch::parallelHeapSort(std::vector<TodoItem>& items, ThreadPool& pool) {
+    // heapSort's max-heap leaves the most urgent item last
+    auto less = [](const TodoItem& a, const TodoItem& b) { return compareByPriority(b, a); };
+    auto leaf = [&less](TodoItem* first, TodoItem* last) {
+        std::make_heap(first, last, less);
+        std::sort_heap(first, last, less);
+    };
+    if (items.size() <= PARALLEL_CUTOFF) {
+        leaf(items.data(), items.data() + items.size());
+        return;
+    }
+    ScratchBuffer scratch(items.size(), pool);
+    mergeSortTask(items.data(), scratch.data(), items.size(), false, less, leaf, PARALLEL_CUTOFF, pool);
+}
+
+std::vector<uint32_t> SortSearch::orderByPriority(const std::vector<TodoItem>& items) {
+    std::vector<uint32_t> order(items.size());
+    std::vector<uint8_t> keys(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+        keys[i] = static_cast<uint8_t>(static_cast<int>(Priority::URGENT) - static_cast<int>(items[i].priority));
+    }
+    countingSort(order, keys, 4);
+    return order;
+}
+
+std::vector<uint32_t> SortSearch::orderByStatus(const std::vector<TodoItem>& items) {
+    std::vector<uint32_t> order(items.size());
+    std::vector<uint8_t> keys(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+        keys[i] = static_cast<uint8_t>(items[i].status);
+    }
+    countingSort(order, keys, 3);
+    return order;
+}
+
+std::vector<uint32_t> SortSearch::orderByDueDate(const std::vector<TodoItem>& items) {
+    std::vector<uint32_t> order(items.size());
+    std::vector<uint32_t> keys(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+        keys[i] = dayKey(DueDateIndex::parseDay(items[i].dueDate));
+    }
+    radixSort(order, keys);
+    return order;
+}
+
+std::vector<uint32_t> SortSearch::orderById(const std::vector<TodoItem>& items) {
+    std::vector<uint32_t> order(items.size());
+    std::vector<uint32_t> keys(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+        keys[i] = idKey(items[i].id);
+    }
+    radixSort(order, keys);
+    return order;
+}
+
+void SortSearch::applyOrder(std::vector<TodoItem>& items, const std::vector<uint32_t>& order) {
+    std::vector<TodoItem> sorted;
+    sorted.reserve(items.size());
+    for (uint32_t from : order) {
+        sorted.push_back(std::move(items[from]));
+    }
+    items.swap(sorted);
+}
+
 // Comparison functions
 bool SortSearch::compareById(const TodoItem& a, const TodoItem& b) {
     return a.id < b.id;
@@ -1,8 +1,12 @@
 #ifndef SORTSEARCH_H
 #define SORTSEARCH_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include "../models/TodoItem.h"
+#include "../utils/ThreadPool.h"
 
 class SortSearch {
 public:
@@ -17,6 +21,41 @@ public:
     static void heapSort(std::vector<TodoItem>& items);
     static void bubbleSort(std::vector<TodoItem>& items);
     
+    // The three above on a thread pool, by the same keys: quick sort by
+    // priority (urgent first), merge sort by due date (and stable), heap
+    // sort by priority (low first). Ranges split into tasks down to a cutoff,
+    // items move between the vector and one scratch buffer, and each merge
+    // is shared between threads by co-ranking. The sequential versions
+    // stay as the baseline
+    static void parallelQuickSort(std::vector<TodoItem>& items, ThreadPool& pool = ThreadPool::shared());
+    static void parallelMergeSort(std::vector<TodoItem>& items, ThreadPool& pool = ThreadPool::shared());
+    static void parallelHeapSort(std::vector<TodoItem>& items, ThreadPool& pool = ThreadPool::shared());
+    
+    // Linear-time stable sorts of values by a parallel array of keys
+    // (keys[i] belongs to values[i]). Values are meant to be small - item
+    // positions or handles - so whole TodoItems never move.
+    // Counting sort for keys below buckets: one counting pass, one scatter
+    template <typename T>
+    static void countingSort(std::vector<T>& values, const std::vector<uint8_t>& keys, size_t buckets);
+    // LSD radix sort, 11 bits per pass; a pass where every key has the
+    // same digit is skipped. keys end up permuted along with values
+    template <typename T>
+    static void radixSort(std::vector<T>& values, std::vector<uint32_t>& keys);
+    
+    // Positions of items in field order, stable. Priority is urgent first,
+    // status pending first, and todos without a valid due date come first
+    static std::vector<uint32_t> orderByPriority(const std::vector<TodoItem>& items);
+    static std::vector<uint32_t> orderByStatus(const std::vector<TodoItem>& items);
+    static std::vector<uint32_t> orderByDueDate(const std::vector<TodoItem>& items);
+    static std::vector<uint32_t> orderById(const std::vector<TodoItem>& items);
+    // Rearrange items into order (a permutation of positions), moving each
+    // item once
+    static void applyOrder(std::vector<TodoItem>& items, const std::vector<uint32_t>& order);
+    
+    // Radix keys that sort unsigned in the same order as the signed value
+    static uint32_t dayKey(int32_t day) { return static_cast<uint32_t>(day) ^ 0x80000000u; }
+    static uint32_t idKey(int id) { return static_cast<uint32_t>(id) ^ 0x80000000u; }
+    
     // Utility functions
     static int partition(std::vector<TodoItem>& items, int low, int high);
     static void merge(std::vector<TodoItem>& items, int left, int mid, int right);
@@ -29,4 +68,60 @@ public:
     static bool compareByStatus(const TodoItem& a, const TodoItem& b);
 };
 
+template <typename T>
+void SortSearch::countingSort(std::vector<T>& values, const std::vector<uint8_t>& keys, size_t buckets) {
+    std::vector<size_t> start(buckets + 1, 0);
+    for (uint8_t key : keys) start[key + 1]++;
+    for (size_t b = 1; b <= buckets; b++) start[b] += start[b - 1];
+    
+    std::vector<T> sorted(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        sorted[start[keys[i]]++] = values[i];
+    }
+    values.swap(sorted);
+}
+
+template <typename T>
+void SortSearch::radixSort(std::vector<T>& values, std::vector<uint32_t>& keys) {
+    constexpr int BITS = 11;
+    constexpr int PASSES = (32 + BITS - 1) / BITS;
+    constexpr uint32_t MASK = (1u << BITS) - 1;
+    const size_t n = values.size();
+    
+    // Every pass's histogram in one read of the keys
+    std::vector<std::array<size_t, MASK + 1>> counts(PASSES);
+    for (auto& count : counts) count.fill(0);
+    for (uint32_t key : keys) {
+        for (int pass = 0; pass < PASSES; pass++) {
+            counts[pass][(key >> (pass * BITS)) & MASK]++;
+        }
+    }
+    
+    std::vector<T> otherValues;
+    std::vector<uint32_t> otherKeys;
+    for (int pass = 0; pass < PASSES; pass++) {
+        auto& count = counts[pass];
+        unsigned shift = pass * BITS;
+        if (n == 0 || count[(keys[0] >> shift) & MASK] == n) continue;
+        
+        size_t offset = 0;
+        for (size_t& c : count) {
+            size_t here = c;
+            c = offset;
+            offset += here;
+        }
+        if (otherValues.empty()) {
+            otherValues.resize(n);
+            otherKeys.resize(n);
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t to = count[(keys[i] >> shift) & MASK]++;
+            otherValues[to] = values[i];
+            otherKeys[to] = keys[i];
+        }
+        values.swap(otherValues);
+        keys.swap(otherKeys);
+    }
+}
+
 #endif // SORTSEARCH_H
\ No newline at end of file
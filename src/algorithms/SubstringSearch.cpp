@@ -0,0 +1,285 @@
+#include "SubstringSearch.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SUBSTRING_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+constexpr size_t npos = std::string_view::npos;
+
+inline unsigned char fold(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+}
+
+inline unsigned char upper(unsigned char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<unsigned char>(c - ('a' - 'A')) : c;
+}
+
+// Kernels take a pattern that is already folded when Fold is set, with
+// 1 <= patternLength; they return npos when there is no match.
+// Checks the middle of a candidate inline: a memcmp call inside the
+// vector loops makes the compiler spill the loop state around it
+template <bool Fold>
+inline bool equalBytes(const char* text, const char* pattern, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if ((Fold ? fold(c) : c) != static_cast<unsigned char>(pattern[i])) return false;
+    }
+    return true;
+}
+
+template <bool Fold>
+size_t findScalar(const char* text, size_t length, const char* pattern, size_t patternLength) {
+    if (!Fold) {
+        return std::string_view(text, length).find(std::string_view(pattern, patternLength));
+    }
+    unsigned char first = static_cast<unsigned char>(pattern[0]);
+    for (size_t i = 0; i + patternLength <= length; i++) {
+        if (fold(static_cast<unsigned char>(text[i])) == first &&
+            equalBytes<true>(text + i + 1, pattern + 1, patternLength - 1)) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+#ifdef SUBSTRING_SEARCH_X86
+
+inline unsigned firstBit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Candidates whose first and last bytes match are checked in the middle;
+// the tail that cannot fill a whole vector goes to the scalar kernel
+template <bool Fold>
+size_t findSSE2(const char* text, size_t length, const char* pattern, size_t patternLength) {
+    const size_t lastOffset = patternLength - 1;
+    const unsigned char first = static_cast<unsigned char>(pattern[0]);
+    const unsigned char last = static_cast<unsigned char>(pattern[lastOffset]);
+    const __m128i firstLower = _mm_set1_epi8(static_cast<char>(first));
+    const __m128i firstUpper = _mm_set1_epi8(static_cast<char>(upper(first)));
+    const __m128i lastLower = _mm_set1_epi8(static_cast<char>(last));
+    const __m128i lastUpper = _mm_set1_epi8(static_cast<char>(upper(last)));
+
+    size_t i = 0;
+    for (; i + lastOffset + 16 <= length; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + lastOffset));
+        __m128i firstHits = _mm_cmpeq_epi8(head, firstLower);
+        __m128i lastHits = _mm_cmpeq_epi8(tail, lastLower);
+        if (Fold) {
+            firstHits = _mm_or_si128(firstHits, _mm_cmpeq_epi8(head, firstUpper));
+            lastHits = _mm_or_si128(lastHits, _mm_cmpeq_epi8(tail, lastUpper));
+        }
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(firstHits, lastHits)));
+        while (mask) {
+            size_t at = i + firstBit(mask);
+            if (patternLength <= 2 || equalBytes<Fold>(text + at + 1, pattern + 1, patternLength - 2)) {
+                return at;
+            }
+            mask &= mask - 1;
+        }
+    }
+    size_t rest = findScalar<Fold>(text + i, length - i, pattern, patternLength);
+    return rest == npos ? npos : i + rest;
+}
+
+#if defined(__GNUC__)
+#define SUBSTRING_SEARCH_AVX2 1
+
+template <bool Fold>
+__attribute__((target("avx2")))
+inline uint32_t avx2Mask(const char* text, size_t lastOffset, __m256i firstLower, __m256i firstUpper,
+                         __m256i lastLower, __m256i lastUpper) {
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + lastOffset));
+    __m256i firstHits = _mm256_cmpeq_epi8(head, firstLower);
+    __m256i lastHits = _mm256_cmpeq_epi8(tail, lastLower);
+    if (Fold) {
+        firstHits = _mm256_or_si256(firstHits, _mm256_cmpeq_epi8(head, firstUpper));
+        lastHits = _mm256_or_si256(lastHits, _mm256_cmpeq_epi8(tail, lastUpper));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(firstHits, lastHits)));
+}
+
+// 64 bytes per step keeps enough loads in flight to stream from L3/DRAM
+template <bool Fold>
+__attribute__((target("avx2")))
+size_t findAVX2(const char* text, size_t length, const char* pattern, size_t patternLength) {
+    const size_t lastOffset = patternLength - 1;
+    const unsigned char first = static_cast<unsigned char>(pattern[0]);
+    const unsigned char last = static_cast<unsigned char>(pattern[lastOffset]);
+    const __m256i firstLower = _mm256_set1_epi8(static_cast<char>(first));
+    const __m256i firstUpper = _mm256_set1_epi8(static_cast<char>(upper(first)));
+    const __m256i lastLower = _mm256_set1_epi8(static_cast<char>(last));
+    const __m256i lastUpper = _mm256_set1_epi8(static_cast<char>(upper(last)));
+
+    size_t i = 0;
+    for (; i + lastOffset + 64 <= length; i += 64) {
+        uint64_t mask =
+            avx2Mask<Fold>(text + i, lastOffset, firstLower, firstUpper, lastLower, lastUpper) |
+            uint64_t(avx2Mask<Fold>(text + i + 32, lastOffset, firstLower, firstUpper, lastLower,
+                                    lastUpper)) << 32;
+        while (mask) {
+            size_t at = i + static_cast<size_t>(__builtin_ctzll(mask));
+            if (patternLength <= 2 || equalBytes<Fold>(text + at + 1, pattern + 1, patternLength - 2)) {
+                return at;
+            }
+            mask &= mask - 1;
+        }
+    }
+    // Finish on SSE2 so a short tail does not fall all the way to scalar
+    size_t rest = findSSE2<Fold>(text + i, length - i, pattern, patternLength);
+    return rest == npos ? npos : i + rest;
+}
+#endif // __GNUC__
+
+#endif // SUBSTRING_SEARCH_X86
+
+using FindFn = size_t (*)(const char*, size_t, const char*, size_t);
+
+struct KernelFns {
+    FindFn exact;
+    FindFn folded;
+};
+
+bool kernelSupported(SubstringSearch::Kernel kernel) {
+    switch (kernel) {
+    case SubstringSearch::Kernel::SCALAR:
+        return true;
+#ifdef SUBSTRING_SEARCH_X86
+    case SubstringSearch::Kernel::SSE2:
+        return true; // baseline on x86-64
+#ifdef SUBSTRING_SEARCH_AVX2
+    case SubstringSearch::Kernel::AVX2:
+        __builtin_cpu_init(); // may run before other static initializers
+        return __builtin_cpu_supports("avx2");
+#endif
+#endif
+    default:
+        return false;
+    }
+}
+
+KernelFns fnsFor(SubstringSearch::Kernel kernel) {
+    switch (kernel) {
+#ifdef SUBSTRING_SEARCH_X86
+    case SubstringSearch::Kernel::SSE2:
+        return {findSSE2<false>, findSSE2<true>};
+#ifdef SUBSTRING_SEARCH_AVX2
+    case SubstringSearch::Kernel::AVX2:
+        return {findAVX2<false>, findAVX2<true>};
+#endif
+#endif
+    default:
+        return {findScalar<false>, findScalar<true>};
+    }
+}
+
+SubstringSearch::Kernel bestKernel() {
+    if (kernelSupported(SubstringSearch::Kernel::AVX2)) return SubstringSearch::Kernel::AVX2;
+    if (kernelSupported(SubstringSearch::Kernel::SSE2)) return SubstringSearch::Kernel::SSE2;
+    return SubstringSearch::Kernel::SCALAR;
+}
+
+SubstringSearch::Kernel currentKernel = bestKernel();
+KernelFns kernels = fnsFor(currentKernel);
+
+// The pattern as the kernels expect it; folded points into storage
+FindFn prepare(std::string_view& pattern, bool ignoreCase, std::string& folded) {
+    if (!ignoreCase) return kernels.exact;
+    folded.resize(pattern.size());
+    std::transform(pattern.begin(), pattern.end(), folded.begin(), [](char c) {
+        return static_cast<char>(fold(static_cast<unsigned char>(c)));
+    });
+    pattern = folded;
+    return kernels.folded;
+}
+
+} // namespace
+
+size_t SubstringSearch::find(std::string_view text, std::string_view pattern, bool ignoreCase) {
+    if (pattern.empty()) return 0;
+    if (pattern.size() > text.size()) return npos;
+    std::string folded;
+    FindFn findFn = prepare(pattern, ignoreCase, folded);
+    return findFn(text.data(), text.size(), pattern.data(), pattern.size());
+}
+
+SubstringSearch::Kernel SubstringSearch::activeKernel() {
+    return currentKernel;
+}
+
+bool SubstringSearch::useKernel(Kernel kernel) {
+    if (!kernelSupported(kernel)) return false;
+    currentKernel = kernel;
+    kernels = fnsFor(kernel);
+    return true;
+}
+
+const char* SubstringSearch::kernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::SSE2: return "SSE2";
+    case Kernel::AVX2: return "AVX2";
+    default:           return "scalar";
+    }
+}
+
+void TextArena::reserve(size_t rows, size_t byteCount) {
+    starts.reserve(rows + 1);
+    bytes.reserve(byteCount + rows);
+}
+
+void TextArena::add(std::string_view text) {
+    bytes.append(text.data(), text.size());
+    bytes.push_back('\0');
+    starts.push_back(bytes.size());
+}
+
+void TextArena::clear() {
+    bytes.clear();
+    starts.assign(1, 0);
+}
+
+// One kernel call per match: after a hit the scan resumes at the next row
+std::vector<uint32_t> TextArena::search(std::string_view pattern, bool ignoreCase) const {
+    std::vector<uint32_t> rows;
+    if (pattern.empty()) {
+        rows.resize(size());
+        for (size_t r = 0; r < rows.size(); r++) rows[r] = static_cast<uint32_t>(r);
+        return rows;
+    }
+
+    std::string folded;
+    FindFn findFn = prepare(pattern, ignoreCase, folded);
+    size_t from = 0;
+    size_t row = 0;
+    while (from + pattern.size() <= bytes.size()) {
+        size_t hit = findFn(bytes.data() + from, bytes.size() - from, pattern.data(), pattern.size());
+        if (hit == npos) break;
+        hit += from;
+        row = std::upper_bound(starts.begin() + row + 1, starts.end(), hit) - starts.begin() - 1;
+        size_t next = starts[row + 1];
+        if (hit + pattern.size() < next) {
+            rows.push_back(static_cast<uint32_t>(row));
+            from = next;
+        } else {
+            from = hit + 1; // ran into the separator (pattern holds a NUL)
+        }
+    }
+    return rows;
+}
@@ -0,0 +1,55 @@
+#ifndef SUBSTRINGSEARCH_H
+#define SUBSTRINGSEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Brute-force substring search for when no index can narrow the rows.
+// The vector kernels compare the pattern's first and last bytes against
+// 16 or 32 positions at once (SSE2 / AVX2, chosen at runtime) and only
+// compare the middle where both hit, so most of the text is touched by
+// two loads and a mask test. Case-insensitive search folds ASCII letters.
+class SubstringSearch {
+public:
+    enum class Kernel { SCALAR, SSE2, AVX2 };
+
+    // Offset of the first occurrence of pattern in text, or npos
+    static size_t find(std::string_view text, std::string_view pattern, bool ignoreCase = false);
+
+    // Kernel selection; the best supported kernel is used by default
+    static Kernel activeKernel();
+    static bool useKernel(Kernel kernel); // false if the CPU lacks it
+    static const char* kernelName(Kernel kernel);
+};
+
+// Many short strings packed back to back, each followed by a NUL, so a
+// whole column (e.g. every title) is searched in one pass over contiguous
+// memory instead of one find() per scattered std::string.
+class TextArena {
+public:
+    TextArena() : starts{0} {}
+
+    void reserve(size_t rows, size_t bytes);
+    void add(std::string_view text);
+    void clear();
+
+    size_t size() const { return starts.size() - 1; }
+    bool empty() const { return size() == 0; }
+    size_t byteCount() const { return bytes.size(); }
+    const char* data() const { return bytes.data(); }
+    std::string_view at(size_t row) const {
+        return std::string_view(bytes.data() + starts[row], starts[row + 1] - starts[row] - 1);
+    }
+
+    // Rows containing pattern, ascending
+    std::vector<uint32_t> search(std::string_view pattern, bool ignoreCase = false) const;
+
+private:
+    std::string bytes;
+    std::vector<size_t> starts; // row r is bytes[starts[r], starts[r + 1] - 1)
+};
+
+#endif // SUBSTRINGSEARCH_H
@@ -0,0 +1,384 @@
+#include "QueryCursor.h"
+#include "TodoController.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+// Assumed share of rows passing one unindexed title / description condition
+constexpr double TEXT_SELECTIVITY = 0.1;
+
+} // namespace
+
+QueryCursor::QueryCursor(Query query)
+    : query(std::move(query)), access(AccessPath::FULL_SCAN), estimate(0),
+      needsSort(false), exhausted(false), finished(false), emitted(0), examined(0),
+      idValue(0), group(0), nextDay(DueDateIndex::NO_DATE), lastDay(INT32_MAX),
+      nextSlot(0), sortedPos(0) {
+    plan();
+}
+
+const char* QueryCursor::pathName(AccessPath path) {
+    switch (path) {
+        case AccessPath::ID_LOOKUP: return "id index";
+        case AccessPath::BITMAP: return "bitmap index";
+        case AccessPath::DUE_INDEX: return "due-date index";
+        case AccessPath::GROUP_ORDER: return "ordered bitmaps";
+        case AccessPath::TEXT_INDEX: return "text index";
+        case AccessPath::TRIGRAM_INDEX: return "trigram index";
+        case AccessPath::FULL_SCAN: return "full scan";
+        default: return "unknown";
+    }
+}
+
+void QueryCursor::plan() {
+    const Aggregates& stats = TodoController::aggregates;
+    size_t total = stats.total();
+    auto trigramsFor = [](QueryField field) -> const TrigramIndex& {
+        return field == QueryField::TITLE ? TodoController::titleTrigrams
+                                          : TodoController::descriptionTrigrams;
+    };
+
+    // Fold the conditions into accepted enum values and one due interval
+    bool priorityOk[Aggregates::PRIORITIES];
+    bool statusOk[Aggregates::STATUSES];
+    std::fill(std::begin(priorityOk), std::end(priorityOk), true);
+    std::fill(std::begin(statusOk), std::end(statusOk), true);
+    bool priorityFiltered = false, statusFiltered = false, dueFiltered = false, hasId = false;
+    int64_t dayLo = int64_t(DueDateIndex::NO_DATE) + 1, dayHi = INT32_MAX;
+    int textConditions = 0;
+    const QueryPredicate* keywords = nullptr; // text~ condition with the fewest rows
+    size_t keywordRows = total;
+    const QueryPredicate* substring = nullptr; // title/description ~ or = with the fewest rows
+    size_t substringRows = total;
+    for (const QueryPredicate& predicate : query.predicates) {
+        int64_t lo, hi;
+        switch (predicate.field) {
+            case QueryField::PRIORITY:
+                for (int p = 0; p < Aggregates::PRIORITIES; p++) priorityOk[p] &= predicate.accepts(p);
+                priorityFiltered = true;
+                break;
+            case QueryField::STATUS:
+                for (int s = 0; s < Aggregates::STATUSES; s++) statusOk[s] &= predicate.accepts(s);
+                statusFiltered = true;
+                break;
+            case QueryField::DUE:
+                if (predicate.range(lo, hi)) {
+                    dayLo = std::max(dayLo, lo);
+                    dayHi = std::min(dayHi, hi);
+                    dueFiltered = true;
+                }
+                break;
+            case QueryField::ID:
+                if (predicate.op == QueryOp::EQ) {
+                    hasId = true;
+                    idValue = static_cast<int32_t>(predicate.number);
+                }
+                break;
+            case QueryField::TEXT: {
+                size_t rows = TodoController::textIndex.estimate(predicate.words);
+                if (!keywords || rows < keywordRows) {
+                    keywords = &predicate;
+                    keywordRows = rows;
+                }
+                break;
+            }
+            case QueryField::TITLE:
+            case QueryField::DESCRIPTION:
+                if (predicate.op == QueryOp::CONTAINS || predicate.op == QueryOp::EQ) {
+                    size_t rows = trigramsFor(predicate.field).estimate(predicate.text);
+                    if (rows != SIZE_MAX) {
+                        if (!substring || rows < substringRows) {
+                            substring = &predicate;
+                            substringRows = rows;
+                        }
+                        break;
+                    }
+                }
+                textConditions++;
+                break;
+        }
+    }
+
+    // Exact row counts for each index
+    size_t pairRows = 0; // accepted priority and status
+    for (int p = 0; p < Aggregates::PRIORITIES; p++) {
+        for (int s = 0; s < Aggregates::STATUSES; s++) {
+            if (priorityOk[p] && statusOk[s]) {
+                pairRows += stats.count(static_cast<Priority>(p), static_cast<Status>(s));
+            }
+        }
+    }
+    int32_t firstDay = DueDateIndex::NO_DATE;
+    size_t dueRows = total;
+    if (dueFiltered) {
+        firstDay = static_cast<int32_t>(std::min<int64_t>(dayLo, INT32_MAX));
+        lastDay = static_cast<int32_t>(std::max<int64_t>(dayHi, DueDateIndex::NO_DATE));
+        dueRows = dayLo <= dayHi ? TodoController::dueIndex.count(firstDay, lastDay) : 0;
+    }
+
+    // Expected matches, treating conditions on different fields as independent
+    double matches = static_cast<double>(total);
+    if (total > 0) {
+        matches *= double(pairRows) / double(total) * (double(dueRows) / double(total));
+        matches *= std::pow(TEXT_SELECTIVITY, textConditions);
+        matches *= double(keywordRows) / double(total);
+        matches *= double(substringRows) / double(total);
+    }
+
+    // Rows a path reads: with the limit pushed down an in-order path stops
+    // after about limit / (share of its rows that match)
+    auto cost = [&](size_t rows, bool inOrder) {
+        double all = static_cast<double>(rows);
+        if (!inOrder || query.limit == 0 || rows == 0) return all;
+        return std::min(all, double(query.limit) * all / std::max(matches, 1.0));
+    };
+
+    bool byDue = query.orderField == QueryField::DUE && !query.descending;
+    bool byGroup = query.orderField == QueryField::PRIORITY || query.orderField == QueryField::STATUS;
+    bool inOrder = !query.ordered;
+    double bestCost = cost(total, inOrder);
+    estimate = total;
+    auto consider = [&](AccessPath path, size_t rows, bool pathInOrder) {
+        double pathCost = cost(rows, pathInOrder);
+        if (pathCost < bestCost || (pathCost == bestCost && pathInOrder && !inOrder)) {
+            access = path;
+            estimate = rows;
+            inOrder = pathInOrder;
+            bestCost = pathCost;
+        }
+    };
+    if (hasId) {
+        consider(AccessPath::ID_LOOKUP, std::min<size_t>(total, 1), true);
+    }
+    if (priorityFiltered || statusFiltered) {
+        consider(AccessPath::BITMAP, pairRows, !query.ordered);
+    }
+    if (dueFiltered || (query.ordered && byDue)) {
+        consider(AccessPath::DUE_INDEX, dueRows, !query.ordered || byDue);
+    }
+    if (query.ordered && byGroup) {
+        consider(AccessPath::GROUP_ORDER, pairRows, true);
+    }
+    if (keywords) {
+        consider(AccessPath::TEXT_INDEX, keywordRows, !query.ordered);
+    }
+    if (substring) {
+        consider(AccessPath::TRIGRAM_INDEX, substringRows, !query.ordered);
+    }
+    needsSort = query.ordered && !inOrder;
+
+    // Set up the chosen path. A single accepted value uses the live bitmap;
+    // anything else is combined once here (word-level work, no rows read).
+    owned.reserve(Aggregates::PRIORITIES + 2);
+    auto select = [this](const auto& maps, const bool* ok) -> const RoaringBitmap* {
+        std::vector<size_t> values;
+        for (size_t v = 0; v < maps.size(); v++) {
+            if (ok[v]) values.push_back(v);
+        }
+        if (values.size() == 1) return &maps[values[0]];
+        RoaringBitmap combined;
+        for (size_t v : values) combined = RoaringBitmap::unite(combined, maps[v]);
+        owned.push_back(std::move(combined));
+        return &owned.back();
+    };
+    switch (access) {
+        case AccessPath::BITMAP: {
+            const RoaringBitmap* byPriority =
+                priorityFiltered ? select(TodoController::priorityBitmaps, priorityOk) : nullptr;
+            const RoaringBitmap* byStatus =
+                statusFiltered ? select(TodoController::statusBitmaps, statusOk) : nullptr;
+            if (byPriority && byStatus) {
+                owned.push_back(RoaringBitmap::intersect(*byPriority, *byStatus));
+                groups.push_back(&owned.back());
+            } else {
+                groups.push_back(byPriority ? byPriority : byStatus);
+            }
+            break;
+        }
+        case AccessPath::GROUP_ORDER: {
+            bool byPriority = query.orderField == QueryField::PRIORITY;
+            const RoaringBitmap* other = nullptr;
+            if (byPriority && statusFiltered) other = select(TodoController::statusBitmaps, statusOk);
+            if (!byPriority && priorityFiltered) other = select(TodoController::priorityBitmaps, priorityOk);
+            int values = byPriority ? Aggregates::PRIORITIES : Aggregates::STATUSES;
+            for (int i = 0; i < values; i++) {
+                int v = query.descending ? values - 1 - i : i;
+                if (!(byPriority ? priorityOk[v] : statusOk[v])) continue;
+                const RoaringBitmap& bitmap = byPriority ? TodoController::priorityBitmaps[v]
+                                                         : TodoController::statusBitmaps[v];
+                if (other) {
+                    owned.push_back(RoaringBitmap::intersect(bitmap, *other));
+                    groups.push_back(&owned.back());
+                } else {
+                    groups.push_back(&bitmap);
+                }
+            }
+            break;
+        }
+        case AccessPath::TEXT_INDEX:
+            owned.push_back(TodoController::textIndex.candidates(keywords->words));
+            groups.push_back(&owned.back());
+            break;
+        case AccessPath::TRIGRAM_INDEX: {
+            RoaringBitmap slots;
+            trigramsFor(substring->field).candidates(substring->text, slots);
+            owned.push_back(std::move(slots));
+            groups.push_back(&owned.back());
+            break;
+        }
+        case AccessPath::DUE_INDEX:
+            nextDay = firstDay;
+            break;
+        default:
+            break;
+    }
+}
+
+template <typename Fn>
+void QueryCursor::drive(Fn fn) {
+    if (exhausted) return;
+    const SlotMap& storage = TodoController::todosStorage;
+    bool stopped = false;
+    auto visit = [&](uint32_t slot) {
+        nextSlot = uint64_t(slot) + 1;
+        examined++;
+        if (!storage.isLive(slot) || !query.matches(storage.at(slot))) return true;
+        stopped = !fn(slot);
+        return !stopped;
+    };
+
+    switch (access) {
+        case AccessPath::ID_LOOKUP: {
+            size_t slot = TodoController::idIndex.find(idValue);
+            if (slot != IdIndex::NPOS) visit(static_cast<uint32_t>(slot));
+            exhausted = true;
+            return;
+        }
+        case AccessPath::BITMAP:
+        case AccessPath::GROUP_ORDER:
+        case AccessPath::TEXT_INDEX:
+        case AccessPath::TRIGRAM_INDEX:
+            for (; group < groups.size(); group++, nextSlot = 0) {
+                if (nextSlot <= UINT32_MAX) {
+                    groups[group]->forEachFrom(static_cast<uint32_t>(nextSlot), visit);
+                }
+                if (stopped) return;
+            }
+            break;
+        case AccessPath::DUE_INDEX:
+            TodoController::dueIndex.forEachFrom(nextDay, nextSlot, lastDay,
+                                                 [&](int32_t day, uint32_t slot) {
+                nextDay = day;
+                return visit(slot);
+            });
+            if (stopped) return;
+            break;
+        case AccessPath::FULL_SCAN:
+            for (uint64_t slot = nextSlot; slot < storage.capacity(); slot++) {
+                if (!visit(static_cast<uint32_t>(slot))) return;
+            }
+            break;
+    }
+    exhausted = true;
+}
+
+std::vector<TodoHandle> QueryCursor::next(size_t count) {
+    std::vector<TodoHandle> results;
+    if (finished) return results;
+
+    if (needsSort) {
+        if (!exhausted) sortAll();
+        size_t end = count ? std::min(sorted.size(), sortedPos + count) : sorted.size();
+        results.assign(sorted.begin() + sortedPos, sorted.begin() + end);
+        sortedPos = end;
+        finished = sortedPos == sorted.size();
+        return results;
+    }
+
+    const SlotMap& storage = TodoController::todosStorage;
+    drive([&](uint32_t slot) {
+        results.push_back(storage.handleAt(slot));
+        emitted++;
+        return (query.limit == 0 || emitted < query.limit) && (count == 0 || results.size() < count);
+    });
+    finished = exhausted || (query.limit != 0 && emitted >= query.limit);
+    return results;
+}
+
+// Top-k with a bounded max-heap (its front is the worst row kept), or a
+// full sort without a limit; ties go by slot
+void QueryCursor::sortAll() {
+    struct Row {
+        int64_t key;
+        uint32_t slot;
+    };
+    const SlotMap& storage = TodoController::todosStorage;
+    QueryField field = query.orderField;
+    bool descending = query.descending;
+    bool byText = field == QueryField::TITLE || field == QueryField::DESCRIPTION;
+
+    auto textOf = [&](uint32_t slot) -> const std::string& {
+        const TodoItem& todo = storage.at(slot);
+        return field == QueryField::TITLE ? todo.title : todo.description;
+    };
+    auto keyOf = [field](const TodoItem& todo) -> int64_t {
+        switch (field) {
+            case QueryField::ID: return todo.id;
+            case QueryField::DUE: return DueDateIndex::parseDay(todo.dueDate);
+            case QueryField::PRIORITY: return static_cast<int64_t>(todo.priority);
+            case QueryField::STATUS: return static_cast<int64_t>(todo.status);
+            default: return 0;
+        }
+    };
+    auto before = [&](const Row& a, const Row& b) {
+        if (byText) {
+            int order = textOf(a.slot).compare(textOf(b.slot));
+            if (order != 0) return descending ? order > 0 : order < 0;
+        } else if (a.key != b.key) {
+            return descending ? a.key > b.key : a.key < b.key;
+        }
+        return a.slot < b.slot;
+    };
+
+    size_t k = query.limit;
+    std::vector<Row> rows;
+    if (k) rows.reserve(k);
+    drive([&](uint32_t slot) {
+        Row row{keyOf(storage.at(slot)), slot};
+        if (k == 0 || rows.size() < k) {
+            rows.push_back(row);
+            if (rows.size() == k) std::make_heap(rows.begin(), rows.end(), before);
+        } else if (before(row, rows.front())) {
+            std::pop_heap(rows.begin(), rows.end(), before);
+            rows.back() = row;
+            std::push_heap(rows.begin(), rows.end(), before);
+        }
+        return true;
+    });
+    if (k != 0 && rows.size() == k) {
+        std::sort_heap(rows.begin(), rows.end(), before);
+    } else {
+        std::sort(rows.begin(), rows.end(), before);
+    }
+
+    sorted.reserve(rows.size());
+    for (const Row& row : rows) sorted.push_back(storage.handleAt(row.slot));
+    emitted = sorted.size();
+}
+
+std::string QueryCursor::explain() const {
+    std::ostringstream out;
+    out << pathName(access);
+    if (access == AccessPath::GROUP_ORDER) out << " by " << Query::fieldName(query.orderField);
+    out << ", ~" << estimate << " rows";
+    if (needsSort) {
+        if (query.limit) out << ", top-" << query.limit;
+        else out << ", full";
+        out << " sort by " << Query::fieldName(query.orderField) << (query.descending ? " desc" : "");
+    } else if (query.limit) {
+        out << ", limit " << query.limit << " pushed down";
+    }
+    return out.str();
+}
@@ -0,0 +1,86 @@
+#ifndef QUERYCURSOR_H
+#define QUERYCURSOR_H
+
+#include "../models/Query.h"
+#include "../models/RoaringBitmap.h"
+#include "../models/SlotMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How a query reaches its candidate rows
+enum class AccessPath {
+    ID_LOOKUP,     // id = N through the id hash index
+    BITMAP,        // priority / status conditions as one combined bitmap
+    DUE_INDEX,     // a due-day range, in due order
+    GROUP_ORDER,   // one priority (or status) bitmap at a time, in that order
+    TEXT_INDEX,    // slots holding the keywords of a text~ condition
+    TRIGRAM_INDEX, // candidates for a title / description ~ or = condition
+    FULL_SCAN      // every slot
+};
+
+// Lazy result stream for a Query, opened with TodoController::openQuery.
+//
+// The planner counts the rows each usable index would yield (exact from
+// the aggregates cube and the due index, upper bounds from the text and
+// trigram indexes) and drives the query from the cheapest; every row it yields is then checked against all conditions.
+// When that path already produces rows in the requested order the limit
+// is pushed down, so "limit 20" stops after 20 matches. Otherwise the
+// first fetch keeps the best `limit` rows in a bounded heap, O(n log k).
+//
+// Each next() resumes where the last one stopped. Todos changed between
+// fetches are re-checked, but one moved into a range the cursor has
+// already passed is not seen.
+class QueryCursor {
+public:
+    // Movable only: groups point into owned
+    QueryCursor(QueryCursor&&) = default;
+    QueryCursor& operator=(QueryCursor&&) = default;
+    QueryCursor(const QueryCursor&) = delete;
+    QueryCursor& operator=(const QueryCursor&) = delete;
+
+    // Up to count more results (0 = all remaining); empty once exhausted
+    std::vector<TodoHandle> next(size_t count = 0);
+    bool done() const { return finished; }
+
+    AccessPath path() const { return access; }
+    size_t estimatedRows() const { return estimate; }
+    size_t rowsExamined() const { return examined; }
+    // Plan summary, e.g. "due index, ~120 rows, limit 20 pushed down"
+    std::string explain() const;
+
+    static const char* pathName(AccessPath path);
+
+private:
+    friend class TodoController;
+    explicit QueryCursor(Query query);
+
+    Query query;
+    AccessPath access;
+    size_t estimate;
+    bool needsSort; // the path does not yield rows in query order
+    bool exhausted; // the path has no rows left
+    bool finished;
+    size_t emitted;
+    size_t examined;
+
+    // Resume state of the driving path
+    int32_t idValue;
+    std::vector<RoaringBitmap> owned;         // combined bitmaps built for this query
+    std::vector<const RoaringBitmap*> groups; // one, or one per value for GROUP_ORDER
+    size_t group;
+    int32_t nextDay, lastDay;                 // DUE_INDEX
+    uint64_t nextSlot;
+    std::vector<TodoHandle> sorted;           // results of a sorted query
+    size_t sortedPos;
+
+    void plan();
+    // Calls fn(slot) for every matching row from the resume point until it
+    // returns false or the path runs out
+    template <typename Fn>
+    void drive(Fn fn);
+    void sortAll();
+};
+
+#endif // QUERYCURSOR_H
@@ -1,11 +1,12 @@
 #include "../utils/ColorManager.h"
 #include "TodoController.h"
+#include "../algorithms/SortSearch.h"
 #include <iostream>
 #include <algorithm>
 #include <ctime>
 
 // Initialize with demo data
-std::vector<TodoItem> TodoController::todosStorage = {
+SlotMap TodoController::todosStorage = {
     TodoItem(1, "Complete Project Report", "Finish DSA project with algorithms", "2025-02-15", Priority::HIGH),
     TodoItem(2, "Buy Groceries", "Milk, Eggs, Bread, Fruits", "2023-05-05", Priority::MEDIUM),
     TodoItem(3, "Doctor Appointment", "Annual health checkup", "2025-10-10", Priority::HIGH),
@@ -13,19 +14,38 @@ std::vector<TodoItem> TodoController::todosStorage = {
     TodoItem(5, "Team Meeting", "Weekly sync with team", "2025-06-20", Priority::URGENT)
 };
 
-TodoController::TodoController() : nextId(6) {
-    loadFromFile();
-    // Mark some demo todos as completed
-    markAsComplete(1);
-    markAsComplete(3);
+IdIndex TodoController::idIndex;
+std::array<RoaringBitmap, 4> TodoController::priorityBitmaps;
+std::array<RoaringBitmap, 3> TodoController::statusBitmaps;
+DueDateIndex TodoController::dueIndex;
+Aggregates TodoController::aggregates;
+TextIndex TodoController::textIndex;
+TrigramIndex TodoController::titleTrigrams;
+TrigramIndex TodoController::descriptionTrigrams;
+TitleTrie TodoController::titleTrie;
+TopKCache TodoController::urgentCache;
+TextArena TodoController::titleArena;
+TextArena TodoController::descriptionArena;
+
+TodoController::TodoController()
+    : groupCommit([this] { journal.sync(); }), durable(true), nextId(6) {
+    rebuildIndex();
+    if (!loadFromFile()) {
+        // Mark some demo todos as completed
+        markAsComplete(1);
+        markAsComplete(3);
+    }
 }
 
 void TodoController::addTodo(const std::string& title, const std::string& description,
                             const std::string& dueDate, Priority priority) {
     TodoItem newTodo(nextId, title, description, dueDate, priority);
-    todosStorage.push_back(newTodo);
+    TodoHandle handle = todosStorage.insert(newTodo);
+    idIndex.insert(newTodo.id, handle.slot);
+    indexFields(handle.slot, newTodo);
     nextId++;
-    saveToFile();
+    journal.appendUpsert(newTodo);
+    commitMutation();
 }
 
 bool TodoController::updateTodo(int id, const std::string& title,
@@ -33,199 +53,561 @@ bool TodoController::updateTodo(int id, const std::string& title,
                                const std::string& dueDate,
                                Priority priority,
                                Status status) {
-    for (auto& todo : todosStorage) {
-        if (todo.id == id) {
-            if (!title.empty()) todo.title = title;
-            if (!description.empty()) todo.description = description;
-            if (!dueDate.empty()) todo.dueDate = dueDate;
-            if (priority != Priority::MEDIUM) todo.priority = priority;
-            if (status != Status::PENDING) todo.status = status;
-            
-            todo.updatedAt = std::time(nullptr);
-            saveToFile();
-            return true;
-        }
+    size_t slot = idIndex.find(id);
+    if (slot == IdIndex::NPOS) {
+        return false;
     }
-    return false;
+    
+    TodoItem* todo = &todosStorage.at(static_cast<uint32_t>(slot));
+    unindexFields(static_cast<uint32_t>(slot), *todo);
+    if (!title.empty()) todo->title = title;
+    if (!description.empty()) todo->description = description;
+    if (!dueDate.empty()) todo->dueDate = dueDate;
+    if (priority != Priority::MEDIUM) todo->priority = priority;
+    if (status != Status::PENDING) todo->status = status;
+    indexFields(static_cast<uint32_t>(slot), *todo);
+    
+    todo->updatedAt = std::time(nullptr);
+    journal.appendUpsert(*todo);
+    commitMutation();
+    return true;
 }
 
 bool TodoController::deleteTodo(int id) {
-    auto it = std::remove_if(todosStorage.begin(), todosStorage.end(),
-                            [id](const TodoItem& todo) { return todo.id == id; });
-    
-    if (it != todosStorage.end()) {
-        todosStorage.erase(it, todosStorage.end());
-        saveToFile();
-        return true;
+    size_t slot = idIndex.find(id);
+    if (slot == IdIndex::NPOS) {
+        return false;
     }
-    return false;
+    
+    // O(1): nothing else moves, so the indexes only lose this slot
+    unindexFields(static_cast<uint32_t>(slot), todosStorage.at(static_cast<uint32_t>(slot)));
+    todosStorage.erase(todosStorage.handleAt(static_cast<uint32_t>(slot)));
+    idIndex.erase(id);
+    
+    journal.appendRemove(id);
+    fileHandler.recordRemoval(id);
+    commitMutation();
+    return true;
 }
 
 bool TodoController::markAsComplete(int id) {
-    for (auto& todo : todosStorage) {
-        if (todo.id == id) {
-            todo.status = Status::COMPLETED;
-            todo.updatedAt = std::time(nullptr);
-            saveToFile();
-            return true;
-        }
+    size_t slot = idIndex.find(id);
+    if (slot == IdIndex::NPOS) {
+        return false;
     }
-    return false;
+    
+    TodoItem* todo = &todosStorage.at(static_cast<uint32_t>(slot));
+    int32_t dueDay = DueDateIndex::parseDay(todo->dueDate);
+    statusBitmaps[static_cast<int>(todo->status)].remove(static_cast<uint32_t>(slot));
+    aggregates.remove(todo->priority, todo->status, dueDay);
+    todo->status = Status::COMPLETED;
+    statusBitmaps[static_cast<int>(todo->status)].add(static_cast<uint32_t>(slot));
+    aggregates.add(todo->priority, todo->status, dueDay);
+    urgentCache.remove(static_cast<uint32_t>(slot));
+    todo->updatedAt = std::time(nullptr);
+    journal.appendStatus(id, todo->status, todo->updatedAt);
+    commitMutation();
+    return true;
 }
 
 bool TodoController::markAsInProgress(int id) {
-    for (auto& todo : todosStorage) {
-        if (todo.id == id) {
-            todo.status = Status::IN_PROGRESS;
-            todo.updatedAt = std::time(nullptr);
-            saveToFile();
-            return true;
-        }
+    size_t slot = idIndex.find(id);
+    if (slot == IdIndex::NPOS) {
+        return false;
+    }
+    
+    TodoItem* todo = &todosStorage.at(static_cast<uint32_t>(slot));
+    int32_t dueDay = DueDateIndex::parseDay(todo->dueDate);
+    bool wasCompleted = todo->status == Status::COMPLETED;
+    statusBitmaps[static_cast<int>(todo->status)].remove(static_cast<uint32_t>(slot));
+    aggregates.remove(todo->priority, todo->status, dueDay);
+    todo->status = Status::IN_PROGRESS;
+    statusBitmaps[static_cast<int>(todo->status)].add(static_cast<uint32_t>(slot));
+    aggregates.add(todo->priority, todo->status, dueDay);
+    if (wasCompleted) {
+        urgentCache.offer(static_cast<uint32_t>(slot),
+                          TopKCache::urgencyKey(static_cast<uint32_t>(slot), todo->priority, dueDay));
     }
-    return false;
+    todo->updatedAt = std::time(nullptr);
+    journal.appendStatus(id, todo->status, todo->updatedAt);
+    commitMutation();
+    return true;
 }
 
 TodoItem* TodoController::searchById(int id) {
-    for (auto& todo : todosStorage) {
-        if (todo.id == id) {
-            return &todo;
+    size_t slot = idIndex.find(id);
+    return slot == IdIndex::NPOS ? nullptr : &todosStorage.at(static_cast<uint32_t>(slot));
+}
+
+TodoHandle TodoController::findHandle(int id) const {
+    size_t slot = idIndex.find(id);
+    return slot == IdIndex::NPOS ? TodoHandle{} : todosStorage.handleAt(static_cast<uint32_t>(slot));
+}
+
+TodoItem* TodoController::resolve(TodoHandle handle) {
+    return todosStorage.get(handle);
+}
+
+const TodoItem* TodoController::resolve(TodoHandle handle) const {
+    return todosStorage.get(handle);
+}
+
+std::vector<TodoHandle> TodoController::searchByTitle(const std::string& title, bool ignoreCase) const {
+    return searchSubstring(titleTrigrams, titleArena, &TodoItem::title, title, ignoreCase);
+}
+
+std::vector<TodoHandle> TodoController::searchByDescription(const std::string& text,
+                                                            bool ignoreCase) const {
+    return searchSubstring(descriptionTrigrams, descriptionArena, &TodoItem::description, text,
+                           ignoreCase);
+}
+
+// Results come back in slot order, not display order. The trigrams are
+// byte-exact, so case-insensitive searches always scan.
+std::vector<TodoHandle> TodoController::searchSubstring(const TrigramIndex& index, TextArena& arena,
+                                                        std::string TodoItem::*field,
+                                                        const std::string& pattern,
+                                                        bool ignoreCase) const {
+    std::vector<TodoHandle> results;
+    RoaringBitmap candidates;
+    if (!ignoreCase && index.candidates(pattern, candidates)) {
+        candidates.forEach([&](uint32_t slot) {
+            if ((todosStorage.at(slot).*field).find(pattern) != std::string::npos) {
+                results.push_back(todosStorage.handleAt(slot));
+            }
+            return true;
+        });
+        return results;
+    }
+    
+    // Free slots hold an empty row so rows line up with slots
+    if (arena.empty()) {
+        arena.reserve(todosStorage.capacity(), 0);
+        for (uint32_t slot = 0; slot < todosStorage.capacity(); slot++) {
+            arena.add(todosStorage.isLive(slot) ? std::string_view(todosStorage.at(slot).*field)
+                                                : std::string_view());
         }
     }
-    return nullptr;
+    for (uint32_t slot : arena.search(pattern, ignoreCase)) {
+        if (todosStorage.isLive(slot)) results.push_back(todosStorage.handleAt(slot));
+    }
+    return results;
 }
 
-std::vector<TodoItem*> TodoController::searchByTitle(const std::string& title) {
-    std::vector<TodoItem*> results;
-    for (auto& todo : todosStorage) {
-        if (todo.title.find(title) != std::string::npos) {
-            results.push_back(&todo);
-        }
+std::vector<TodoHandle> TodoController::searchByPriority(Priority priority) const {
+    return toHandles(priorityIndex(priority));
+}
+
+std::vector<TodoHandle> TodoController::searchByStatus(Status status) const {
+    return toHandles(statusIndex(status));
+}
+
+const RoaringBitmap& TodoController::priorityIndex(Priority priority) const {
+    return priorityBitmaps[static_cast<int>(priority)];
+}
+
+const RoaringBitmap& TodoController::statusIndex(Status status) const {
+    return statusBitmaps[static_cast<int>(status)];
+}
+
+// Results come back in slot order, not display order
+std::vector<TodoHandle> TodoController::toHandles(const RoaringBitmap& slots, size_t limit) const {
+    std::vector<TodoHandle> handles;
+    handles.reserve(limit ? std::min(limit, slots.cardinality()) : slots.cardinality());
+    slots.forEach([&](uint32_t slot) {
+        handles.push_back(todosStorage.handleAt(slot));
+        return limit == 0 || handles.size() < limit;
+    });
+    return handles;
+}
+
+std::vector<TodoHandle> TodoController::searchByPriorityAndStatus(Priority priority, Status status,
+                                                                  bool excludeStatus) const {
+    const RoaringBitmap& byPriority = priorityIndex(priority);
+    const RoaringBitmap& byStatus = statusIndex(status);
+    return toHandles(excludeStatus ? RoaringBitmap::difference(byPriority, byStatus)
+                                   : RoaringBitmap::intersect(byPriority, byStatus));
+}
+
+std::vector<TodoHandle> TodoController::searchByDueRange(const std::string& from, const std::string& to,
+                                                        size_t limit) const {
+    int32_t first = DueDateIndex::parseDay(from);
+    int32_t last = DueDateIndex::parseDay(to);
+    if (first == DueDateIndex::NO_DATE || last == DueDateIndex::NO_DATE) {
+        return {};
+    }
+    
+    std::vector<TodoHandle> results;
+    for (uint32_t slot : dueIndex.range(first, last, limit)) {
+        results.push_back(todosStorage.handleAt(slot));
     }
     return results;
 }
 
-std::vector<TodoItem*> TodoController::searchByPriority(Priority priority) {
-    std::vector<TodoItem*> results;
-    for (auto& todo : todosStorage) {
-        if (todo.priority == priority) {
-            results.push_back(&todo);
+std::vector<TodoHandle> TodoController::searchOverdue(size_t limit) const {
+    std::vector<TodoHandle> results;
+    const RoaringBitmap& completed = statusIndex(Status::COMPLETED);
+    dueIndex.forEach(DueDateIndex::NO_DATE + 1, DueDateIndex::today() - 1, [&](int32_t, uint32_t slot) {
+        if (!completed.contains(slot)) {
+            results.push_back(todosStorage.handleAt(slot));
         }
+        return limit == 0 || results.size() < limit;
+    });
+    return results;
+}
+
+std::vector<TodoHandle> TodoController::nextDue(size_t count) const {
+    std::vector<TodoHandle> results;
+    if (count == 0) return results;
+    const RoaringBitmap& completed = statusIndex(Status::COMPLETED);
+    dueIndex.forEach(DueDateIndex::today(), INT32_MAX, [&](int32_t, uint32_t slot) {
+        if (!completed.contains(slot)) {
+            results.push_back(todosStorage.handleAt(slot));
+        }
+        return results.size() < count;
+    });
+    return results;
+}
+
+std::vector<TodoHandle> TodoController::searchText(const std::string& query, size_t limit) const {
+    std::vector<TodoHandle> results;
+    for (const auto& hit : textIndex.search(TextQuery::parse(query), todosStorage, limit)) {
+        results.push_back(todosStorage.handleAt(hit.first));
+    }
+    return results;
+}
+
+const TextIndex& TodoController::getTextIndex() const {
+    return textIndex;
+}
+
+std::vector<TodoHandle> TodoController::completeTitle(const std::string& prefix, size_t limit) const {
+    std::vector<TodoHandle> results;
+    for (uint32_t slot : titleTrie.complete(prefix, limit)) {
+        results.push_back(todosStorage.handleAt(slot));
     }
     return results;
 }
 
-std::vector<TodoItem*> TodoController::searchByStatus(Status status) {
-    std::vector<TodoItem*> results;
-    for (auto& todo : todosStorage) {
-        if (todo.status == status) {
-            results.push_back(&todo);
+std::vector<TodoHandle> TodoController::nextTasks(size_t k) const {
+    std::vector<TodoHandle> results;
+    if (k == 0) return results;
+    if (urgentCache.covers(k)) {
+        const std::vector<TopKCache::Row>& rows = urgentCache.best();
+        results.reserve(std::min(k, rows.size()));
+        for (size_t i = 0; i < rows.size() && i < k; i++) {
+            results.push_back(todosStorage.handleAt(rows[i].slot));
         }
+        return results;
+    }
+    
+    // Answer from the fresh selection: the cache keeps at most
+    // MAX_CAPACITY rows of it
+    bool whole = false;
+    std::vector<TopKCache::Row> rows = selectUrgent(std::max(k, urgentCache.limit()), whole);
+    results.reserve(std::min(k, rows.size()));
+    for (size_t i = 0; i < rows.size() && i < k; i++) {
+        results.push_back(todosStorage.handleAt(rows[i].slot));
+    }
+    if (rows.size() > TopKCache::MAX_CAPACITY) {
+        rows.resize(TopKCache::MAX_CAPACITY);
+        whole = false;
     }
+    urgentCache.assign(std::move(rows), whole);
     return results;
 }
 
+std::vector<TopKCache::Row> TodoController::selectUrgent(size_t k, bool& whole) const {
+    // Quotas in rank order: a priority's dated todos, then its undated
+    // ones, then the next priority
+    std::array<size_t, 4> dated{}, undated{};
+    size_t remaining = k;
+    for (int p = static_cast<int>(Priority::URGENT); p >= 0; p--) {
+        Priority priority = static_cast<Priority>(p);
+        size_t open = aggregates.countByPriority(priority) - aggregates.count(priority, Status::COMPLETED);
+        size_t noDate = aggregates.count(priority, Status::PENDING, DueBucket::NO_DATE) +
+                        aggregates.count(priority, Status::IN_PROGRESS, DueBucket::NO_DATE);
+        dated[p] = std::min(remaining, open - noDate);
+        remaining -= dated[p];
+        undated[p] = std::min(remaining, noDate);
+        remaining -= undated[p];
+    }
+    
+    const RoaringBitmap& completed = statusIndex(Status::COMPLETED);
+    std::vector<TopKCache::Row> rows;
+    rows.reserve(k - remaining);
+    auto pick = [&](std::array<size_t, 4>& quota, int32_t first, int32_t last) {
+        size_t left = 0;
+        for (size_t q : quota) left += q;
+        if (left == 0) return;
+        dueIndex.forEach(first, last, [&](int32_t day, uint32_t slot) {
+            if (completed.contains(slot)) return true;
+            for (int p = static_cast<int>(Priority::URGENT); p >= 0; p--) {
+                if (quota[p] == 0 || !priorityBitmaps[p].contains(slot)) continue;
+                rows.push_back({TopKCache::urgencyKey(slot, static_cast<Priority>(p), day), slot});
+                quota[p]--;
+                left--;
+                break;
+            }
+            return left > 0;
+        });
+    };
+    pick(dated, DueDateIndex::NO_DATE + 1, INT32_MAX);
+    pick(undated, DueDateIndex::NO_DATE, DueDateIndex::NO_DATE);
+    
+    std::sort(rows.begin(), rows.end(),
+              [](const TopKCache::Row& a, const TopKCache::Row& b) { return a.key < b.key; });
+    whole = remaining > 0;
+    return rows;
+}
+
+QueryCursor TodoController::openQuery(const Query& query) const {
+    return QueryCursor(query);
+}
+
+std::vector<TodoHandle> TodoController::runQuery(const Query& query) const {
+    return openQuery(query).next();
+}
+
+size_t TodoController::countByPriorityAndStatus(Priority priority, Status status,
+                                                 bool excludeStatus) const {
+    size_t matching = aggregates.count(priority, status);
+    return excludeStatus ? aggregates.countByPriority(priority) - matching : matching;
+}
+
+// The display-order sorts are stable and linear: the handles are sorted by
+// a key array gathered in one read of the todos, and the todos stay put
 void TodoController::sortByPriority() {
-    std::sort(todosStorage.begin(), todosStorage.end(),
-              [](const TodoItem& a, const TodoItem& b) {
-                  return static_cast<int>(a.priority) > static_cast<int>(b.priority);
-              });
+    std::vector<TodoHandle> order = todosStorage.handles();
+    std::vector<uint8_t> keys(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        Priority priority = todosStorage.at(order[i].slot).priority;
+        keys[i] = static_cast<uint8_t>(static_cast<int>(Priority::URGENT) - static_cast<int>(priority));
+    }
+    SortSearch::countingSort(order, keys, 4);
+    todosStorage.setOrder(std::move(order));
 }
 
+// The due index is already in day order, so this is a walk, not a sort;
+// todos without a valid date come first
 void TodoController::sortByDueDate() {
-    std::sort(todosStorage.begin(), todosStorage.end(),
-              [](const TodoItem& a, const TodoItem& b) {
-                  return a.dueDate < b.dueDate;
-              });
+    std::vector<TodoHandle> order;
+    order.reserve(todosStorage.size());
+    dueIndex.forEach(DueDateIndex::NO_DATE, INT32_MAX, [&](int32_t, uint32_t slot) {
+        order.push_back(todosStorage.handleAt(slot));
+        return true;
+    });
+    todosStorage.setOrder(std::move(order));
 }
 
 void TodoController::sortByStatus() {
-    std::sort(todosStorage.begin(), todosStorage.end(),
-              [](const TodoItem& a, const TodoItem& b) {
-                  return static_cast<int>(a.status) < static_cast<int>(b.status);
-              });
+    std::vector<TodoHandle> order = todosStorage.handles();
+    std::vector<uint8_t> keys(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        keys[i] = static_cast<uint8_t>(todosStorage.at(order[i].slot).status);
+    }
+    SortSearch::countingSort(order, keys, 3);
+    todosStorage.setOrder(std::move(order));
 }
 
 void TodoController::sortById() {
-    std::sort(todosStorage.begin(), todosStorage.end(),
-              [](const TodoItem& a, const TodoItem& b) {
-                  return a.id < b.id;
-              });
+    std::vector<TodoHandle> order = todosStorage.handles();
+    std::vector<uint32_t> keys(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        keys[i] = SortSearch::idKey(todosStorage.at(order[i].slot).id);
+    }
+    SortSearch::radixSort(order, keys);
+    todosStorage.setOrder(std::move(order));
+}
+
+// Buckets are relative to today, so a new day first moves the todos whose
+// due day crossed a bucket edge; every other read is O(1)
+void TodoController::refreshDueBuckets() const {
+    int32_t today = DueDateIndex::today();
+    if (today == aggregates.day()) return;
+    
+    int32_t first, last;
+    aggregates.staleWindow(today, first, last);
+    dueIndex.forEach(first, last, [&](int32_t day, uint32_t slot) {
+        const TodoItem& todo = todosStorage.at(slot);
+        aggregates.moveToDay(todo.priority, todo.status, day, today);
+        return true;
+    });
+    aggregates.setDay(today);
+}
+
+const Aggregates& TodoController::getAggregates() const {
+    refreshDueBuckets();
+    return aggregates;
+}
+
+size_t TodoController::getTotalCount() const {
+    return aggregates.total();
 }
 
 int TodoController::getCompletedCount() const {
-    int count = 0;
-    for (const auto& todo : todosStorage) {
-        if (todo.status == Status::COMPLETED) count++;
-    }
-    return count;
+    return static_cast<int>(aggregates.countByStatus(Status::COMPLETED));
 }
 
 int TodoController::getPendingCount() const {
-    int count = 0;
-    for (const auto& todo : todosStorage) {
-        if (todo.status == Status::PENDING) count++;
-    }
-    return count;
+    return static_cast<int>(aggregates.countByStatus(Status::PENDING));
 }
 
 int TodoController::getInProgressCount() const {
-    int count = 0;
-    for (const auto& todo : todosStorage) {
-        if (todo.status == Status::IN_PROGRESS) count++;
-    }
-    return count;
+    return static_cast<int>(aggregates.countByStatus(Status::IN_PROGRESS));
 }
 
 void TodoController::showStatistics() const {
-    int total = todosStorage.size();
-    int completed = getCompletedCount();
-    int pending = getPendingCount();
-    int inProgress = getInProgressCount();
+    const Aggregates& stats = getAggregates();
     
     std::cout << "\n=== Statistics ===" << std::endl;
-    std::cout << "Total Todos: " << total << std::endl;
-    std::cout << "Completed: " << completed << std::endl;
-    std::cout << "In Progress: " << inProgress << std::endl;
-    std::cout << "Pending: " << pending << std::endl;
+    std::cout << "Total Todos: " << stats.total() << std::endl;
+    std::cout << "Completed: " << stats.countByStatus(Status::COMPLETED) << std::endl;
+    std::cout << "In Progress: " << stats.countByStatus(Status::IN_PROGRESS) << std::endl;
+    std::cout << "Pending: " << stats.countByStatus(Status::PENDING) << std::endl;
+    std::cout << "Overdue: " << stats.countByBucket(DueBucket::OVERDUE) << std::endl;
     
+    const size_t MAX_LISTED_IDS = 20;
     std::cout << "\nAvailable IDs: ";
-    for (const auto& todo : todosStorage) {
-        std::cout << todo.id << " ";
+    for (int id : getIds(MAX_LISTED_IDS)) {
+        std::cout << id << " ";
+    }
+    if (stats.total() > MAX_LISTED_IDS) {
+        std::cout << "... and " << stats.total() - MAX_LISTED_IDS << " more";
     }
     std::cout << std::endl;
 }
 
-
 // File Operations
 bool TodoController::saveToFile() {
-    // Simple save implementation for now
-    std::cout << "Data saved successfully" << std::endl;
-    return true;
+    if (!fileHandler.saveToFile(todosStorage)) {
+        return false;
+    }
+    
+    // The snapshot now covers every journaled edit
+    return journal.reset();
 }
 
 bool TodoController::loadFromFile() {
-    // For demo, just use the sample data
+    PriorityQueue snapshot;
+    bool loaded = fileHandler.loadFromFile(snapshot);
+    std::vector<TodoItem> items = loaded ? snapshot.release() : todosStorage.release();
+    
+    // Re-apply edits made after the last snapshot
+    size_t replayed = journal.replay(items);
+    todosStorage.assign(std::move(items));
+    rebuildIndex();
+    if (!loaded && replayed == 0) {
+        return false;
+    }
+    
+    for (const auto& todo : todosStorage) {
+        if (todo.id >= nextId) nextId = todo.id + 1;
+    }
     return true;
 }
 
-bool TodoController::createBackup() {
-    // Convert todosStorage to vector for backup
-    std::vector<TodoItem> todosVector = todosStorage;
-    return fileHandler.createBackup(todosVector);
+void TodoController::rebuildIndex() {
+    idIndex.clear();
+    idIndex.reserve(todosStorage.size());
+    for (auto& bitmap : priorityBitmaps) bitmap.clear();
+    for (auto& bitmap : statusBitmaps) bitmap.clear();
+    dueIndex.clear();
+    aggregates.clear(DueDateIndex::today());
+    textIndex.clear();
+    titleTrigrams.clear();
+    descriptionTrigrams.clear();
+    titleTrie.clear();
+    urgentCache.clear();
+    titleArena.clear();
+    descriptionArena.clear();
+    
+    std::vector<std::pair<int32_t, uint32_t>> dueDays;
+    dueDays.reserve(todosStorage.size());
+    for (auto it = todosStorage.begin(); it != todosStorage.end(); ++it) {
+        uint32_t slot = it.handle().slot;
+        idIndex.insert(it->id, slot);
+        priorityBitmaps[static_cast<int>(it->priority)].add(slot);
+        statusBitmaps[static_cast<int>(it->status)].add(slot);
+        dueDays.emplace_back(DueDateIndex::parseDay(it->dueDate), slot);
+        aggregates.add(it->priority, it->status, dueDays.back().first);
+        textIndex.insert(slot, it->title, it->description);
+        titleTrigrams.insert(slot, it->title);
+        descriptionTrigrams.insert(slot, it->description);
+        titleTrie.insert(slot, it->title, it->priority, dueDays.back().first);
+    }
+    dueIndex.insertAll(dueDays);
+}
+
+void TodoController::indexFields(uint32_t slot, const TodoItem& todo) {
+    priorityBitmaps[static_cast<int>(todo.priority)].add(slot);
+    statusBitmaps[static_cast<int>(todo.status)].add(slot);
+    int32_t dueDay = DueDateIndex::parseDay(todo.dueDate);
+    dueIndex.insert(dueDay, slot);
+    aggregates.add(todo.priority, todo.status, dueDay);
+    textIndex.insert(slot, todo.title, todo.description);
+    titleTrigrams.insert(slot, todo.title);
+    descriptionTrigrams.insert(slot, todo.description);
+    titleTrie.insert(slot, todo.title, todo.priority, dueDay);
+    if (todo.status != Status::COMPLETED) {
+        urgentCache.offer(slot, TopKCache::urgencyKey(slot, todo.priority, dueDay));
+    }
+    titleArena.clear();
+    descriptionArena.clear();
+}
+
+void TodoController::unindexFields(uint32_t slot, const TodoItem& todo) {
+    priorityBitmaps[static_cast<int>(todo.priority)].remove(slot);
+    statusBitmaps[static_cast<int>(todo.status)].remove(slot);
+    int32_t dueDay = DueDateIndex::parseDay(todo.dueDate);
+    dueIndex.erase(dueDay, slot);
+    aggregates.remove(todo.priority, todo.status, dueDay);
+    textIndex.remove(slot, todo.title, todo.description);
+    titleTrigrams.remove(slot, todo.title);
+    descriptionTrigrams.remove(slot, todo.description);
+    titleTrie.remove(slot);
+    urgentCache.remove(slot);
+    titleArena.clear();
+    descriptionArena.clear();
+}
+
+void TodoController::commitMutation() {
+    if (durable) {
+        groupCommit.request();
+    }
+    checkpointIfNeeded();
+}
+
+void TodoController::checkpointIfNeeded() {
+    if (journal.needsCheckpoint()) {
+        saveToFile();
+    }
+}
+
+bool TodoController::createBackup(BackupKind kind) {
+    return fileHandler.createBackup(todosStorage, kind);
 }
 
 bool TodoController::exportToCSV() {
-    std::vector<TodoItem> todosVector = todosStorage;
-    return fileHandler.exportToCSV(todosVector);
+    return fileHandler.exportToCSV(todosStorage);
 }
 
 bool TodoController::exportToJSON() {
-    std::vector<TodoItem> todosVector = todosStorage;
-    return fileHandler.exportToJSON(todosVector);
+    return fileHandler.exportToJSON(todosStorage);
+}
+
+bool TodoController::exportToNDJSON() {
+    return fileHandler.exportToNDJSON(todosStorage);
 }
 
 bool TodoController::restoreFromBackup() {
-    return fileHandler.restoreFromBackup();
+    if (!fileHandler.restoreFromBackup()) {
+        return false;
+    }
+    
+    // Old journal records belong to the replaced data
+    journal.reset();
+    return loadFromFile();
 }
 
 void TodoController::showFileStats() const {
@@ -237,15 +619,130 @@ void TodoController::compressOldItems() {
     auto now = std::time(nullptr);
     const int THIRTY_DAYS = 30 * 24 * 60 * 60;
     
-    todosStorage.erase(std::remove_if(todosStorage.begin(), todosStorage.end(),
-        [now, THIRTY_DAYS](const TodoItem& todo) {
-            return todo.status == Status::COMPLETED && 
-                   (now - todo.updatedAt) > THIRTY_DAYS;
-        }), todosStorage.end());
+    std::vector<TodoHandle> old;
+    for (auto it = todosStorage.begin(); it != todosStorage.end(); ++it) {
+        if (it->status == Status::COMPLETED && (now - it->updatedAt) > THIRTY_DAYS) {
+            old.push_back(it.handle());
+        }
+    }
+    
+    for (TodoHandle handle : old) {
+        int id = todosStorage.get(handle)->id;
+        fileHandler.recordRemoval(id);
+        idIndex.erase(id);
+        unindexFields(handle.slot, *todosStorage.get(handle));
+        todosStorage.erase(handle);
+    }
+    
+    if (!old.empty()) {
+        saveToFile();
+    }
+}
+
+size_t TodoController::importFile(const std::string& path, ImportFormat format) {
+    std::vector<TodoItem> imported;
+    ImportStats stats;
+    if (!Importer::importFile(path, imported, stats, format)) {
+        return 0;
+    }
+    
+    std::cout << "📥 Parsed " << stats.records << " todos from " << Importer::formatName(stats.format)
+              << " in " << stats.chunks << " chunk(s)";
+    if (stats.skipped > 0) {
+        std::cout << ", skipped " << stats.skipped << " malformed record(s)";
+    }
+    std::cout << std::endl;
+    
+    size_t count = imported.size();
+    if (count > 0) {
+        bulkLoad(std::move(imported));
+    }
+    return count;
+}
+
+// Imported ids are kept unless they are missing or already taken; those
+// get fresh ids above every id in the store and the import
+void TodoController::bulkLoad(std::vector<TodoItem>&& items) {
+    int maxId = nextId - 1; // nextId is always above every stored id
+    for (const auto& item : items) {
+        maxId = std::max(maxId, item.id);
+    }
+    
+    // The index doubles as the set of taken ids
+    todosStorage.reserve(todosStorage.capacity() + items.size());
+    idIndex.reserve(todosStorage.size() + items.size());
+    size_t renumbered = 0;
+    std::vector<std::pair<int32_t, uint32_t>> dueDays;
+    dueDays.reserve(items.size());
+    for (auto& item : items) {
+        if (item.id <= 0 || idIndex.contains(item.id)) {
+            item.id = ++maxId;
+            renumbered++;
+        }
+        int id = item.id;
+        TodoHandle handle = todosStorage.insert(std::move(item));
+        const TodoItem& todo = todosStorage.at(handle.slot);
+        idIndex.insert(id, handle.slot);
+        priorityBitmaps[static_cast<int>(todo.priority)].add(handle.slot);
+        statusBitmaps[static_cast<int>(todo.status)].add(handle.slot);
+        dueDays.emplace_back(DueDateIndex::parseDay(todo.dueDate), handle.slot);
+        aggregates.add(todo.priority, todo.status, dueDays.back().first);
+        textIndex.insert(handle.slot, todo.title, todo.description);
+        titleTrigrams.insert(handle.slot, todo.title);
+        descriptionTrigrams.insert(handle.slot, todo.description);
+        titleTrie.insert(handle.slot, todo.title, todo.priority, dueDays.back().first);
+    }
+    dueIndex.insertAll(dueDays); // one merge for the whole import
+    urgentCache.clear();
+    titleArena.clear();
+    descriptionArena.clear();
+    if (renumbered > 0) {
+        std::cout << "🔢 Assigned new IDs to " << renumbered << " imported todo(s)" << std::endl;
+    }
+    
+    nextId = maxId + 1;
+    
+    // One snapshot instead of a journal record per item; imported items
+    // keep old timestamps, so the next backup cannot be a delta
+    saveToFile();
+    fileHandler.requireFullBackup();
+}
+
+void TodoController::setCompression(bool enabled) {
+    fileHandler.setCompression(enabled);
+}
+
+bool TodoController::isCompressionEnabled() const {
+    return fileHandler.isCompressionEnabled();
+}
+
+void TodoController::setDurableMode(bool enabled, int groupCommitWindowMs) {
+    durable = enabled;
+    groupCommit.setWindow(std::chrono::milliseconds(groupCommitWindowMs));
+}
+
+void TodoController::waitForDurability() {
+    if (durable) {
+        groupCommit.waitDurable();
+    }
+}
+
+size_t TodoController::getSyncCount() const {
+    return groupCommit.commitCount();
 }
 
 std::vector<TodoItem> TodoController::getAllTodos() const {
-    return todosStorage;
+    return todosStorage.toVector();
+}
+
+std::vector<int> TodoController::getIds(size_t limit) const {
+    std::vector<int> ids;
+    ids.reserve(limit ? std::min(limit, todosStorage.size()) : todosStorage.size());
+    for (const auto& todo : todosStorage) {
+        if (limit != 0 && ids.size() == limit) break;
+        ids.push_back(todo.id);
+    }
+    return ids;
 }
 
 void TodoController::generateNextId() {
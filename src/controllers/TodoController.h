@@ -3,16 +3,77 @@
 
 #include "../models/TodoItem.h"
 #include "../models/PriorityQueue.h"
+#include "../models/IdIndex.h"
+#include "../models/SlotMap.h"
+#include "../models/RoaringBitmap.h"
+#include "../models/DueDateIndex.h"
+#include "../models/Aggregates.h"
+#include "../models/TextIndex.h"
+#include "../models/TrigramIndex.h"
+#include "../models/TitleTrie.h"
+#include "../models/TopKCache.h"
 #include "../utils/FileHandler.h"
+#include "../utils/Journal.h"
+#include "../utils/GroupCommit.h"
+#include "../utils/Importer.h"
+#include "../algorithms/SubstringSearch.h"
+#include "QueryCursor.h"
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <string>
 
 class TodoController {
 private:
-    static std::vector<TodoItem> todosStorage; // Changed to static
+    friend class QueryCursor; // plans over the indexes below
+
+    static SlotMap todosStorage; // Changed to static; items never move
+    static IdIndex idIndex;      // id -> slot in todosStorage
+    // Slots holding each priority / status
+    static std::array<RoaringBitmap, 4> priorityBitmaps;
+    static std::array<RoaringBitmap, 3> statusBitmaps;
+    static DueDateIndex dueIndex; // (due day, slot) in day order
+    static Aggregates aggregates; // priority x status x due bucket counts
+    static TextIndex textIndex;   // words of titles and descriptions
+    static TrigramIndex titleTrigrams;       // substrings of titles
+    static TrigramIndex descriptionTrigrams; // and of descriptions
+    static TitleTrie titleTrie;              // title prefixes for autocomplete
+    static TopKCache urgentCache;            // most urgent open todos, for nextTasks
+    // Titles / descriptions packed by slot for scans the trigrams cannot
+    // answer; emptied by any change and rebuilt by the next scan
+    static TextArena titleArena;
+    static TextArena descriptionArena;
     FileHandler fileHandler;
+    Journal journal;
+    GroupCommit groupCommit;
+    bool durable;
     int nextId;
     
+    // Called after every journaled mutation
+    void commitMutation();
+    // Write a full snapshot once the journal has grown too large
+    void checkpointIfNeeded();
+    // Re-map every id after the storage has been replaced
+    void rebuildIndex();
+    // Add / drop one slot in the priority/status bitmaps, the due index,
+    // the aggregates, the text and trigram indexes and the title trie
+    void indexFields(uint32_t slot, const TodoItem& todo);
+    void unindexFields(uint32_t slot, const TodoItem& todo);
+    // Append many items at once and checkpoint a single time
+    void bulkLoad(std::vector<TodoItem>&& items);
+    // The k most urgent open todos, best first: the aggregates say how many
+    // each priority gives, then one walk of the due index in day order
+    // picks them. whole = fewer than k are open, so these are all of them
+    std::vector<TopKCache::Row> selectUrgent(size_t k, bool& whole) const;
+    // Re-bucket the aggregates once the calendar day has moved on
+    void refreshDueBuckets() const;
+    // Todos whose title (or description) contains pattern: trigram
+    // candidates verified with find, or an arena scan for patterns under
+    // 3 bytes and case-insensitive searches
+    std::vector<TodoHandle> searchSubstring(const TrigramIndex& index, TextArena& arena,
+                                            std::string TodoItem::*field,
+                                            const std::string& pattern, bool ignoreCase) const;
+    
 public:
     TodoController();
     
@@ -31,10 +92,60 @@ public:
     bool markAsInProgress(int id);
     
     // Search Operations
+    // Pointers stay valid until that todo is deleted (storage never moves
+    // items); handles also detect the deletion
     TodoItem* searchById(int id);
-    std::vector<TodoItem*> searchByTitle(const std::string& title);
-    std::vector<TodoItem*> searchByPriority(Priority priority);
-    std::vector<TodoItem*> searchByStatus(Status status);
+    TodoHandle findHandle(int id) const;
+    // ignoreCase folds ASCII letters
+    std::vector<TodoHandle> searchByTitle(const std::string& title, bool ignoreCase = false) const;
+    std::vector<TodoHandle> searchByDescription(const std::string& text, bool ignoreCase = false) const;
+    std::vector<TodoHandle> searchByPriority(Priority priority) const;
+    std::vector<TodoHandle> searchByStatus(Status status) const;
+    TodoItem* resolve(TodoHandle handle);              // nullptr once deleted
+    const TodoItem* resolve(TodoHandle handle) const;
+    
+    // Bitmap indexes over slots; combine them with RoaringBitmap::intersect
+    // and difference, e.g. URGENT and not COMPLETED
+    const RoaringBitmap& priorityIndex(Priority priority) const;
+    const RoaringBitmap& statusIndex(Status status) const;
+    std::vector<TodoHandle> toHandles(const RoaringBitmap& slots, size_t limit = 0) const;
+    std::vector<TodoHandle> searchByPriorityAndStatus(Priority priority, Status status,
+                                                      bool excludeStatus = false) const;
+    size_t countByPriorityAndStatus(Priority priority, Status status,
+                                    bool excludeStatus = false) const;
+    
+    // Agenda queries in due-date order, O(log n + k). Dates are YYYY-MM-DD;
+    // overdue and next-due skip completed todos
+    std::vector<TodoHandle> searchByDueRange(const std::string& from, const std::string& to,
+                                             size_t limit = 0) const;
+    std::vector<TodoHandle> searchOverdue(size_t limit = 0) const;
+    std::vector<TodoHandle> nextDue(size_t count) const;
+    
+    // Ranked keyword search over titles and descriptions (BM25, best
+    // first). Words are ANDed; OR separates alternatives; "..." is a phrase
+    std::vector<TodoHandle> searchText(const std::string& query, size_t limit = 20) const;
+    const TextIndex& getTextIndex() const;
+    
+    // Autocomplete: up to limit todos whose title starts with prefix
+    // (case and spacing ignored), most urgent first, then earliest due
+    std::vector<TodoHandle> completeTitle(const std::string& prefix, size_t limit = 10) const;
+    
+    // The k most urgent open todos: priority, then due date (none last).
+    // Reads come from a small cache that edits keep exact, O(k) when warm.
+    // A refill walks the due index up to the k-th qualifying row, passing
+    // over rows of priorities already filled: O(n) in the worst case. A k
+    // above the cache's capacity is answered from the refill itself
+    std::vector<TodoHandle> nextTasks(size_t k = 10) const;
+    // The k first todos under any ordering (less(a, b): a comes first),
+    // best first, ties by slot; a bounded heap, O(n log k)
+    template <typename Less>
+    std::vector<TodoHandle> topK(size_t k, Less less) const;
+    
+    // Composable queries over all fields, e.g. the parsed form of
+    // status!=completed priority>=high due<2025-07-01 order by due limit 20.
+    // The cursor streams results from the cheapest index (see QueryCursor)
+    QueryCursor openQuery(const Query& query) const;
+    std::vector<TodoHandle> runQuery(const Query& query) const;
     
     // Sorting
     void sortByPriority();
@@ -42,7 +153,9 @@ public:
     void sortByStatus();
     void sortById();
     
-    // Statistics
+    // Statistics, all O(1) reads of the aggregates
+    const Aggregates& getAggregates() const;
+    size_t getTotalCount() const;
     int getCompletedCount() const;
     int getPendingCount() const;
     int getInProgressCount() const;
@@ -51,16 +164,59 @@ public:
     // File Operations
     bool saveToFile();
     bool loadFromFile();
-    bool createBackup();           // <-- ONLY ONE DECLARATION
+    bool createBackup(BackupKind kind = BackupKind::AUTO);
     bool exportToCSV();            // <-- ONLY ONE DECLARATION
     bool exportToJSON();
+    bool exportToNDJSON();
     bool restoreFromBackup();
     void showFileStats() const;
     void compressOldItems();
+    size_t importFile(const std::string& path, ImportFormat format = ImportFormat::AUTO);
+    void setCompression(bool enabled);
+    bool isCompressionEnabled() const;
+    
+    // Durability: journal records are fsynced in group commits
+    void setDurableMode(bool enabled, int groupCommitWindowMs = 10);
+    void waitForDurability();
+    size_t getSyncCount() const;
     
     // Data Access
     std::vector<TodoItem> getAllTodos() const;
+    std::vector<int> getIds(size_t limit = 0) const; // display order, 0 = all
     void generateNextId();
 };
 
+template <typename Less>
+std::vector<TodoHandle> TodoController::topK(size_t k, Less less) const {
+    auto before = [&less](uint32_t a, uint32_t b) {
+        const TodoItem& x = todosStorage.at(a);
+        const TodoItem& y = todosStorage.at(b);
+        if (less(x, y)) return true;
+        if (less(y, x)) return false;
+        return a < b;
+    };
+    
+    if (k == 0) return {};
+    // Max-heap under before: its front is the worst slot kept
+    std::vector<uint32_t> kept;
+    kept.reserve(std::min(k, todosStorage.size()));
+    for (uint32_t slot = 0; slot < todosStorage.capacity(); slot++) {
+        if (!todosStorage.isLive(slot)) continue;
+        if (kept.size() < k) {
+            kept.push_back(slot);
+            std::push_heap(kept.begin(), kept.end(), before);
+        } else if (before(slot, kept.front())) {
+            std::pop_heap(kept.begin(), kept.end(), before);
+            kept.back() = slot;
+            std::push_heap(kept.begin(), kept.end(), before);
+        }
+    }
+    std::sort_heap(kept.begin(), kept.end(), before);
+    
+    std::vector<TodoHandle> results;
+    results.reserve(kept.size());
+    for (uint32_t slot : kept) results.push_back(todosStorage.handleAt(slot));
+    return results;
+}
+
 #endif // TODOCONTROLLER_H
\ No newline at end of file
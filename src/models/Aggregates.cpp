@@ -0,0 +1,61 @@
+#include "Aggregates.h"
+#include "DueDateIndex.h"
+#include <algorithm>
+
+Aggregates::Aggregates(int32_t today) : today(today) {}
+
+DueBucket Aggregates::bucketFor(int32_t dueDay, int32_t today) {
+    if (dueDay == DueDateIndex::NO_DATE) return DueBucket::NO_DATE;
+    if (dueDay < today) return DueBucket::OVERDUE;
+    if (dueDay == today) return DueBucket::TODAY;
+    if (dueDay <= today + WEEK_DAYS) return DueBucket::THIS_WEEK;
+    return DueBucket::LATER;
+}
+
+const char* Aggregates::bucketName(DueBucket bucket) {
+    switch (bucket) {
+        case DueBucket::NO_DATE: return "No Date";
+        case DueBucket::OVERDUE: return "Overdue";
+        case DueBucket::TODAY: return "Today";
+        case DueBucket::THIS_WEEK: return "This Week";
+        case DueBucket::LATER: return "Later";
+        default: return "Unknown";
+    }
+}
+
+void Aggregates::adjust(Priority priority, Status status, DueBucket bucket, long delta) {
+    cube[index(priority)][index(status)][index(bucket)] += delta;
+    byPriorityStatus[index(priority)][index(status)] += delta;
+    byPriority[index(priority)] += delta;
+    byStatus[index(status)] += delta;
+    byBucket[index(bucket)] += delta;
+    all += delta;
+}
+
+void Aggregates::add(Priority priority, Status status, int32_t dueDay) {
+    adjust(priority, status, bucketFor(dueDay, today), 1);
+}
+
+void Aggregates::remove(Priority priority, Status status, int32_t dueDay) {
+    adjust(priority, status, bucketFor(dueDay, today), -1);
+}
+
+void Aggregates::clear(int32_t newToday) {
+    *this = Aggregates(newToday);
+}
+
+// Bucket edges sit at today (overdue / today / this week) and today + 7
+// (this week / later); moving today shifts them across [min, max + 7]
+void Aggregates::staleWindow(int32_t newToday, int32_t& first, int32_t& last) const {
+    first = std::min(today, newToday);
+    last = std::max(today, newToday) + WEEK_DAYS;
+}
+
+void Aggregates::moveToDay(Priority priority, Status status, int32_t dueDay, int32_t newToday) {
+    DueBucket from = bucketFor(dueDay, today);
+    DueBucket to = bucketFor(dueDay, newToday);
+    if (from != to) {
+        adjust(priority, status, from, -1);
+        adjust(priority, status, to, 1);
+    }
+}
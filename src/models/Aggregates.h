@@ -0,0 +1,76 @@
+#ifndef AGGREGATES_H
+#define AGGREGATES_H
+
+#include "TodoItem.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Where a due date falls relative to today
+enum class DueBucket {
+    NO_DATE,
+    OVERDUE,   // before today
+    TODAY,
+    THIS_WEEK, // the next 7 days
+    LATER
+};
+
+// Count cube over priority x status x due bucket, plus its marginals.
+// Every add/remove touches a fixed number of counters, and every read is a
+// single lookup, so statistics cost the same at 10 items or 10M.
+//
+// Due buckets are relative to the day the cube was last moved to; when the
+// calendar day changes the owner calls moveToDay() for each todo whose due
+// day lies in the window returned by staleWindow().
+class Aggregates {
+public:
+    static constexpr int PRIORITIES = 4;
+    static constexpr int STATUSES = 3;
+    static constexpr int BUCKETS = 5;
+    static constexpr int WEEK_DAYS = 7;
+
+    explicit Aggregates(int32_t today = 0);
+
+    static DueBucket bucketFor(int32_t dueDay, int32_t today);
+    static const char* bucketName(DueBucket bucket);
+
+    void add(Priority priority, Status status, int32_t dueDay);
+    void remove(Priority priority, Status status, int32_t dueDay);
+    void clear(int32_t today);
+
+    // Day the buckets are computed against
+    int32_t day() const { return today; }
+    // Due days whose bucket can differ between day() and newToday
+    void staleWindow(int32_t newToday, int32_t& first, int32_t& last) const;
+    // Re-bucket one todo from day() to newToday (call for each todo in the
+    // stale window, then setDay)
+    void moveToDay(Priority priority, Status status, int32_t dueDay, int32_t newToday);
+    void setDay(int32_t newToday) { today = newToday; }
+
+    size_t count(Priority priority, Status status, DueBucket bucket) const {
+        return cube[index(priority)][index(status)][index(bucket)];
+    }
+    size_t count(Priority priority, Status status) const {
+        return byPriorityStatus[index(priority)][index(status)];
+    }
+    size_t countByPriority(Priority priority) const { return byPriority[index(priority)]; }
+    size_t countByStatus(Status status) const { return byStatus[index(status)]; }
+    size_t countByBucket(DueBucket bucket) const { return byBucket[index(bucket)]; }
+    size_t total() const { return all; }
+
+private:
+    std::array<std::array<std::array<size_t, BUCKETS>, STATUSES>, PRIORITIES> cube{};
+    std::array<std::array<size_t, STATUSES>, PRIORITIES> byPriorityStatus{};
+    std::array<size_t, PRIORITIES> byPriority{};
+    std::array<size_t, STATUSES> byStatus{};
+    std::array<size_t, BUCKETS> byBucket{};
+    size_t all = 0;
+    int32_t today;
+
+    template <typename Enum>
+    static size_t index(Enum value) { return static_cast<size_t>(value); }
+
+    void adjust(Priority priority, Status status, DueBucket bucket, long delta);
+};
+
+#endif // AGGREGATES_H
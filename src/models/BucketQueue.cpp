@@ -0,0 +1,111 @@
+#include "BucketQueue.h"
+#include "DueDateIndex.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace {
+
+inline int firstBit(uint64_t word) {
+    return __builtin_ctzll(word);
+}
+
+// Min-heap on the day for std::push_heap / std::pop_heap
+inline bool laterDay(const std::pair<int32_t, TodoHandle>& a, const std::pair<int32_t, TodoHandle>& b) {
+    return a.first > b.first;
+}
+
+} // namespace
+
+int32_t BucketQueue::defaultOrigin() {
+    return DueDateIndex::today() - 1024;
+}
+
+BucketQueue::BucketQueue(int32_t origin) : origin(origin), count(0) {
+    for (Level& level : levels) level.cells.resize(WINDOW);
+}
+
+void BucketQueue::push(TodoHandle handle, Priority priority, int32_t dueDay) {
+    Level& level = levels[static_cast<int>(priority)];
+    int64_t cell = int64_t(dueDay) - origin;
+    if (dueDay != DueDateIndex::NO_DATE && cell >= 0 && cell < WINDOW) {
+        level.cells[cell].push_back(handle);
+        level.days[cell >> 6] |= uint64_t(1) << (cell & 63);
+        level.summary |= uint64_t(1) << (cell >> 6);
+    } else {
+        int32_t day = dueDay == DueDateIndex::NO_DATE ? INT32_MAX : dueDay;
+        level.overflow.emplace_back(day, handle);
+        std::push_heap(level.overflow.begin(), level.overflow.end(), laterDay);
+    }
+    level.count++;
+    count++;
+}
+
+TodoHandle BucketQueue::pop() {
+    if (count == 0) {
+        throw std::runtime_error("Priority queue is empty");
+    }
+
+    Level& level = levels[topLevel()];
+    int cell = firstCell(level);
+    TodoHandle handle;
+    if (cell >= 0 && (level.overflow.empty() || level.overflow.front().first >= origin + cell)) {
+        std::vector<TodoHandle>& handles = level.cells[cell];
+        handle = handles.back();
+        handles.pop_back();
+        if (handles.empty()) {
+            uint64_t& word = level.days[cell >> 6];
+            word &= ~(uint64_t(1) << (cell & 63));
+            if (word == 0) level.summary &= ~(uint64_t(1) << (cell >> 6));
+        }
+    } else {
+        std::pop_heap(level.overflow.begin(), level.overflow.end(), laterDay);
+        handle = level.overflow.back().second;
+        level.overflow.pop_back();
+    }
+    level.count--;
+    count--;
+    return handle;
+}
+
+TodoHandle BucketQueue::peek() const {
+    if (count == 0) {
+        throw std::runtime_error("Priority queue is empty");
+    }
+
+    const Level& level = levels[topLevel()];
+    int cell = firstCell(level);
+    if (cell >= 0 && (level.overflow.empty() || level.overflow.front().first >= origin + cell)) {
+        return level.cells[cell].back();
+    }
+    return level.overflow.front().second;
+}
+
+// Cells keep their capacity so a refilled queue does not allocate again
+void BucketQueue::clear() {
+    for (Level& level : levels) {
+        for (uint64_t summary = level.summary; summary; summary &= summary - 1) {
+            int w = firstBit(summary);
+            for (uint64_t word = level.days[w]; word; word &= word - 1) {
+                level.cells[w * 64 + firstBit(word)].clear();
+            }
+            level.days[w] = 0;
+        }
+        level.summary = 0;
+        level.overflow.clear();
+        level.count = 0;
+    }
+    count = 0;
+}
+
+int BucketQueue::topLevel() const {
+    int p = static_cast<int>(Priority::URGENT);
+    while (levels[p].count == 0) p--;
+    return p;
+}
+
+int BucketQueue::firstCell(const Level& level) {
+    if (level.summary == 0) return -1;
+    int w = firstBit(level.summary);
+    return w * 64 + firstBit(level.days[w]);
+}
@@ -0,0 +1,64 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include "SlotMap.h"
+#include "TodoItem.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Priority queue of todo handles specialized for the four priority levels:
+// most urgent priority first, then earliest due day; todos without a due
+// date come last within their priority, and equal keys leave in no
+// particular order.
+//
+// Each priority is a calendar queue: one cell of handles per day over a
+// WINDOW-day span starting at the origin, plus a two-level bitmap of the
+// non-empty days, so push and pop are O(1) (one find-first-set per level).
+// Days outside the window go to a small per-priority binary heap.
+class BucketQueue {
+public:
+    static constexpr int32_t WINDOW = 4096; // days, about 11 years
+
+    // The window starts at origin; by default a thousand days ago
+    explicit BucketQueue(int32_t origin = defaultOrigin());
+
+    void push(TodoHandle handle, Priority priority, int32_t dueDay);
+    // Throws std::runtime_error when empty, like PriorityQueue
+    TodoHandle pop();
+    TodoHandle peek() const;
+    void clear();
+
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t size(Priority priority) const { return levels[static_cast<int>(priority)].count; }
+
+private:
+    static constexpr int WORDS = WINDOW / 64;
+    static_assert(WORDS <= 64, "the summary word covers at most 64 bitmap words");
+
+    struct Level {
+        std::vector<std::vector<TodoHandle>> cells; // by day - origin
+        std::array<uint64_t, WORDS> days{};         // non-empty cells
+        uint64_t summary = 0;                       // non-empty words of days
+        // (day, handle) min-heap for days outside the window; no due date
+        // is stored as INT32_MAX
+        std::vector<std::pair<int32_t, TodoHandle>> overflow;
+        size_t count = 0;
+    };
+
+    int32_t origin;
+    std::array<Level, 4> levels;
+    size_t count;
+
+    static int32_t defaultOrigin();
+
+    // Most urgent non-empty level; the queue must not be empty
+    int topLevel() const;
+    // Earliest non-empty cell of the level's window, or -1
+    static int firstCell(const Level& level);
+};
+
+#endif // BUCKETQUEUE_H
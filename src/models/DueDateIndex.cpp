@@ -0,0 +1,193 @@
+#include "DueDateIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iterator>
+
+namespace {
+
+// Days from 1970-01-01 to y-m-d in the proleptic Gregorian calendar
+int32_t daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+bool isLeap(int y) {
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+} // namespace
+
+int32_t DueDateIndex::parseDay(std::string_view date) {
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-') return NO_DATE;
+    int digits[8];
+    int n = 0;
+    for (size_t i = 0; i < date.size(); i++) {
+        if (i == 4 || i == 7) continue;
+        if (date[i] < '0' || date[i] > '9') return NO_DATE;
+        digits[n++] = date[i] - '0';
+    }
+
+    int year = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+    unsigned month = static_cast<unsigned>(digits[4] * 10 + digits[5]);
+    unsigned day = static_cast<unsigned>(digits[6] * 10 + digits[7]);
+    static const unsigned monthDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month < 1 || month > 12 || day < 1) return NO_DATE;
+    unsigned last = monthDays[month - 1] + (month == 2 && isLeap(year) ? 1 : 0);
+    if (day > last) return NO_DATE;
+
+    return daysFromCivil(year, month, day);
+}
+
+int32_t DueDateIndex::today() {
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+    return daysFromCivil(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1),
+                         static_cast<unsigned>(local.tm_mday));
+}
+
+size_t DueDateIndex::lowerBound(uint64_t target) const {
+    // Last fence <= target picks the block; the answer is in that block
+    auto fence = std::upper_bound(fences.begin(), fences.end(), target);
+    if (fence == fences.begin()) return 0;
+    size_t block = static_cast<size_t>(fence - fences.begin()) - 1;
+    auto first = run.begin() + block * FENCE_STRIDE;
+    auto last = run.begin() + std::min(run.size(), (block + 1) * FENCE_STRIDE);
+    return static_cast<size_t>(std::lower_bound(first, last, target) - run.begin());
+}
+
+size_t DueDateIndex::lowerBoundIn(const std::vector<uint64_t>& keys, uint64_t target) {
+    return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), target) - keys.begin());
+}
+
+bool DueDateIndex::inRun(uint64_t target) const {
+    size_t pos = lowerBound(target);
+    return pos < run.size() && run[pos] == target;
+}
+
+void DueDateIndex::insert(int32_t day, uint32_t slot) {
+    uint64_t k = key(day, slot);
+    size_t t = lowerBoundIn(removed, k);
+    if (t < removed.size() && removed[t] == k) {
+        removed.erase(removed.begin() + t); // back in the run
+        return;
+    }
+    size_t a = lowerBoundIn(added, k);
+    if ((a < added.size() && added[a] == k) || inRun(k)) return;
+    added.insert(added.begin() + a, k);
+    mergeIfFull();
+}
+
+bool DueDateIndex::erase(int32_t day, uint32_t slot) {
+    uint64_t k = key(day, slot);
+    size_t a = lowerBoundIn(added, k);
+    if (a < added.size() && added[a] == k) {
+        added.erase(added.begin() + a);
+        return true;
+    }
+    if (!inRun(k)) return false;
+    size_t t = lowerBoundIn(removed, k);
+    if (t < removed.size() && removed[t] == k) return false;
+    removed.insert(removed.begin() + t, k);
+    mergeIfFull();
+    return true;
+}
+
+void DueDateIndex::insertAll(const std::vector<std::pair<int32_t, uint32_t>>& entries) {
+    merge();
+    std::vector<uint64_t> keys;
+    keys.reserve(entries.size());
+    for (const auto& entry : entries) {
+        keys.push_back(key(entry.first, entry.second));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    if (run.empty()) {
+        run = std::move(keys);
+    } else {
+        std::vector<uint64_t> merged;
+        merged.reserve(run.size() + keys.size());
+        std::set_union(run.begin(), run.end(), keys.begin(), keys.end(), std::back_inserter(merged));
+        run.swap(merged);
+    }
+    buildFences();
+}
+
+void DueDateIndex::clear() {
+    run.clear();
+    fences.clear();
+    added.clear();
+    removed.clear();
+}
+
+size_t DueDateIndex::count(int32_t first, int32_t last) const {
+    if (first > last) return 0;
+    uint64_t lo = key(first, 0);
+    uint64_t hi = key(last, UINT32_MAX);
+    auto span = [lo, hi](const std::vector<uint64_t>& keys) {
+        return static_cast<size_t>(std::upper_bound(keys.begin(), keys.end(), hi) -
+                                   std::lower_bound(keys.begin(), keys.end(), lo));
+    };
+    size_t end = (hi == UINT64_MAX) ? run.size() : lowerBound(hi + 1);
+    return end - lowerBound(lo) + span(added) - span(removed);
+}
+
+std::vector<uint32_t> DueDateIndex::range(int32_t first, int32_t last, size_t limit) const {
+    std::vector<uint32_t> slots;
+    forEach(first, last, [&](int32_t, uint32_t slot) {
+        slots.push_back(slot);
+        return limit == 0 || slots.size() < limit;
+    });
+    return slots;
+}
+
+// Buffers hold up to sqrt(n) keys: each buffered update is a memmove of
+// O(sqrt n) keys, and the O(n) merge runs once per sqrt(n) updates
+void DueDateIndex::mergeIfFull() {
+    size_t limit = std::max(MIN_BUFFER, static_cast<size_t>(std::sqrt(static_cast<double>(run.size()))));
+    if (added.size() + removed.size() > limit) {
+        merge();
+    }
+}
+
+// In place, so a merge at 10M entries does not allocate: squeeze out the
+// tombstones, then merge the added keys in from the back
+void DueDateIndex::merge() {
+    if (added.empty() && removed.empty()) return;
+
+    size_t kept = 0;
+    size_t t = 0;
+    for (size_t r = 0; r < run.size(); r++) {
+        while (t < removed.size() && removed[t] < run[r]) t++;
+        if (t < removed.size() && removed[t] == run[r]) continue;
+        run[kept++] = run[r];
+    }
+
+    size_t a = added.size();
+    run.resize(kept + a);
+    size_t out = run.size();
+    while (a > 0) {
+        if (kept > 0 && run[kept - 1] > added[a - 1]) {
+            run[--out] = run[--kept];
+        } else {
+            run[--out] = added[--a];
+        }
+    }
+
+    added.clear();
+    removed.clear();
+    buildFences();
+}
+
+void DueDateIndex::buildFences() {
+    fences.clear();
+    fences.reserve(run.size() / FENCE_STRIDE + 1);
+    for (size_t i = 0; i < run.size(); i += FENCE_STRIDE) {
+        fences.push_back(run[i]);
+    }
+}
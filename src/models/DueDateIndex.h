@@ -0,0 +1,102 @@
+#ifndef DUEDATEINDEX_H
+#define DUEDATEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Ordered index of (due day, slot) pairs for agenda queries.
+//
+// The bulk of the entries sit in one sorted run with a fence key for every
+// FENCE_STRIDE entries, so a lookup binary-searches the small fence array
+// and then a single block. Updates go to two small sorted buffers (added
+// entries, and tombstones for removed run entries) that are merged into the
+// run once they hold about sqrt(n) keys. A range query walks the run and
+// the buffers side by side: O(log n + k).
+class DueDateIndex {
+public:
+    // Day number for todos without a parseable due date; sorts first
+    static constexpr int32_t NO_DATE = INT32_MIN;
+
+    // Days since 1970-01-01 for "YYYY-MM-DD", or NO_DATE
+    static int32_t parseDay(std::string_view date);
+    // Local calendar day now
+    static int32_t today();
+
+    DueDateIndex() = default;
+
+    void insert(int32_t day, uint32_t slot);
+    bool erase(int32_t day, uint32_t slot);
+    // Add many entries with one merge instead of one buffer insert each
+    void insertAll(const std::vector<std::pair<int32_t, uint32_t>>& entries);
+    void clear();
+
+    size_t size() const { return run.size() + added.size() - removed.size(); }
+    // Entries with first <= day <= last, in O(log n)
+    size_t count(int32_t first, int32_t last) const;
+
+    // Calls fn(day, slot) in (day, slot) order for first <= day <= last
+    // until it returns false
+    template <typename Fn>
+    void forEach(int32_t first, int32_t last, Fn fn) const {
+        forEachFrom(first, 0, last, fn);
+    }
+
+    // Same, starting at entry (day, slot) inclusive; resumable scans pass
+    // the last (day, slot) seen with slot + 1
+    template <typename Fn>
+    void forEachFrom(int32_t day, uint64_t slot, int32_t last, Fn fn) const {
+        if (day > last || (day == last && slot > UINT32_MAX)) return;
+        uint64_t lo = slot > UINT32_MAX ? key(day + 1, 0) : key(day, static_cast<uint32_t>(slot));
+        uint64_t hi = key(last, UINT32_MAX);
+        size_t r = lowerBound(lo);
+        size_t a = lowerBoundIn(added, lo);
+        size_t t = lowerBoundIn(removed, lo);
+
+        while (true) {
+            // Drop run entries that have a tombstone
+            while (r < run.size() && t < removed.size() && removed[t] <= run[r]) {
+                if (removed[t] == run[r]) r++;
+                t++;
+            }
+            bool haveRun = r < run.size() && run[r] <= hi;
+            bool haveAdded = a < added.size() && added[a] <= hi;
+            if (!haveRun && !haveAdded) return;
+
+            uint64_t next = (haveRun && (!haveAdded || run[r] < added[a])) ? run[r++] : added[a++];
+            if (!fn(dayOf(next), slotOf(next))) return;
+        }
+    }
+
+    // Slots in due order, up to limit (0 = all)
+    std::vector<uint32_t> range(int32_t first, int32_t last, size_t limit = 0) const;
+
+private:
+    static constexpr size_t FENCE_STRIDE = 256;
+    static constexpr size_t MIN_BUFFER = 1024;
+
+    std::vector<uint64_t> run;     // sorted keys
+    std::vector<uint64_t> fences;  // run[i * FENCE_STRIDE]
+    std::vector<uint64_t> added;   // sorted, not in run
+    std::vector<uint64_t> removed; // sorted, in run
+
+    // Day in the high half (sign bit flipped so it sorts unsigned), slot low
+    static uint64_t key(int32_t day, uint32_t slot) {
+        return (uint64_t(uint32_t(day) ^ 0x80000000u) << 32) | slot;
+    }
+    static int32_t dayOf(uint64_t key) { return int32_t(uint32_t(key >> 32) ^ 0x80000000u); }
+    static uint32_t slotOf(uint64_t key) { return uint32_t(key); }
+
+    // First run position with run[pos] >= target, via the fences
+    size_t lowerBound(uint64_t target) const;
+    static size_t lowerBoundIn(const std::vector<uint64_t>& keys, uint64_t target);
+    bool inRun(uint64_t target) const;
+
+    void mergeIfFull();
+    void merge();
+    void buildFences();
+};
+
+#endif // DUEDATEINDEX_H
@@ -0,0 +1,115 @@
+#include "IdIndex.h"
+
+IdIndex::IdIndex() : count(0), mask(0), shift(64) {
+    resize(MIN_CAPACITY);
+}
+
+// Fibonacci hashing: sequential ids spread evenly over the table
+size_t IdIndex::home(int id) const {
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> shift);
+}
+
+size_t IdIndex::probe(int id) const {
+    size_t i = home(id);
+    while (table[i].id != EMPTY && table[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+size_t IdIndex::find(int id) const {
+    if (id == EMPTY) return NPOS;
+    const Entry& entry = table[probe(id)];
+    return entry.id == id ? entry.slot : NPOS;
+}
+
+bool IdIndex::insert(int id, size_t slot) {
+    if (id == EMPTY) return false;
+    // Keep the load factor under 0.7
+    if ((count + 1) * 10 > table.size() * 7) {
+        resize(table.size() * 2);
+    }
+    Entry& entry = table[probe(id)];
+    if (entry.id == id) return false;
+    entry.id = id;
+    entry.slot = static_cast<uint32_t>(slot);
+    count++;
+    return true;
+}
+
+void IdIndex::assign(int id, size_t slot) {
+    if (id == EMPTY) return;
+    size_t i = probe(id);
+    if (table[i].id == id) {
+        table[i].slot = static_cast<uint32_t>(slot);
+    } else {
+        insert(id, slot);
+    }
+}
+
+bool IdIndex::erase(int id) {
+    if (id == EMPTY) return false;
+    size_t hole = probe(id);
+    if (table[hole].id != id) return false;
+
+    // Backward shift: pull later entries of the run into the hole unless
+    // that would move them before their home slot
+    size_t next = hole;
+    while (true) {
+        next = (next + 1) & mask;
+        if (table[next].id == EMPTY) break;
+        size_t want = home(table[next].id);
+        bool movable = hole <= next ? (want <= hole || want > next)
+                                    : (want <= hole && want > next);
+        if (movable) {
+            table[hole] = table[next];
+            hole = next;
+        }
+    }
+    table[hole].id = EMPTY;
+    count--;
+    return true;
+}
+
+void IdIndex::clear() {
+    for (auto& entry : table) {
+        entry.id = EMPTY;
+    }
+    count = 0;
+}
+
+void IdIndex::reserve(size_t wanted) {
+    size_t capacity = table.size();
+    while (wanted * 10 > capacity * 7) {
+        capacity *= 2;
+    }
+    if (capacity != table.size()) {
+        resize(capacity);
+    }
+}
+
+void IdIndex::rebuild(const std::vector<TodoItem>& items) {
+    clear();
+    reserve(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        insert(items[i].id, i);
+    }
+}
+
+void IdIndex::resize(size_t capacity) {
+    std::vector<Entry> old;
+    old.swap(table);
+    table.assign(capacity, Entry{EMPTY, 0});
+    mask = capacity - 1;
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+        shift--;
+    }
+
+    for (const auto& entry : old) {
+        if (entry.id != EMPTY) {
+            table[probe(entry.id)] = entry;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef IDINDEX_H
+#define IDINDEX_H
+
+#include "TodoItem.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Flat open-addressing map from todo id to a position in some vector.
+// Linear probing over a power-of-two table of 8-byte entries keeps a lookup
+// to one or two cache lines; erase shifts the probe run back instead of
+// leaving tombstones, so lookups stay short after heavy churn.
+class IdIndex {
+public:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    IdIndex();
+
+    // Position stored for id, or NPOS
+    size_t find(int id) const;
+    bool contains(int id) const { return find(id) != NPOS; }
+
+    // Add id -> slot; false (and no change) if id is already present
+    bool insert(int id, size_t slot);
+    // Add or overwrite
+    void assign(int id, size_t slot);
+    bool erase(int id);
+
+    void clear();
+    void reserve(size_t count);
+    size_t size() const { return count; }
+
+    // Map items[i].id -> i; the first of any duplicate ids wins
+    void rebuild(const std::vector<TodoItem>& items);
+
+private:
+    struct Entry {
+        int32_t id;
+        uint32_t slot;
+    };
+
+    // INT32_MIN is never a valid id (imports renumber ids <= 0)
+    static constexpr int32_t EMPTY = INT32_MIN;
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    std::vector<Entry> table;
+    size_t count;
+    size_t mask;
+    unsigned shift;
+
+    size_t home(int id) const;
+    // Slot holding id, or the empty slot where it would go
+    size_t probe(int id) const;
+    void resize(size_t capacity);
+};
+
+#endif // IDINDEX_H
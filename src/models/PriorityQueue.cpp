@@ -1,34 +1,107 @@
 #include "PriorityQueue.h"
+#include "../algorithms/SortSearch.h"
 #include <algorithm>
 #include <ctime>
 #include <iostream>
+#include <iterator>
 
-void PriorityQueue::heapifyUp(int index) {
-    while (index > 0 && heap[parent(index)] < heap[index]) {
-        std::swap(heap[parent(index)], heap[index]);
+void PriorityQueue::place(int index, TodoItem&& item) {
+    heap[index] = std::move(item);
+    if (indexed) {
+        positions.assign(heap[index].id, index);
+    }
+}
+
+void PriorityQueue::invalidateIndex() {
+    if (indexed) {
+        positions.clear();
+        indexed = false;
+    }
+}
+
+void PriorityQueue::ensureIndex() {
+    if (!indexed) {
+        positions.rebuild(heap);
+        indexed = true;
+    }
+}
+
+int PriorityQueue::heapifyUp(int index) {
+    if (index == 0 || !(heap[parent(index)] < heap[index])) {
+        return index;
+    }
+    TodoItem item = std::move(heap[index]);
+    while (index > 0 && heap[parent(index)] < item) {
+        place(index, std::move(heap[parent(index)]));
         index = parent(index);
     }
+    place(index, std::move(item));
+    return index;
 }
 
 void PriorityQueue::heapifyDown(int index) {
-    int largest = index;
-    int left = leftChild(index);
-    int right = rightChild(index);
-    
-    if (left < heap.size() && heap[left] > heap[largest])
-        largest = left;
-    
-    if (right < heap.size() && heap[right] > heap[largest])
-        largest = right;
-    
-    if (largest != index) {
-        std::swap(heap[index], heap[largest]);
-        heapifyDown(largest);
+    int size = static_cast<int>(heap.size());
+    TodoItem item = std::move(heap[index]);
+    while (true) {
+        int first = firstChild(index);
+        if (first >= size) break;
+        
+        int largest = first;
+        int last = std::min(first + ARITY, size);
+        for (int child = first + 1; child < last; child++) {
+            if (heap[child] > heap[largest])
+                largest = child;
+        }
+        if (!(heap[largest] > item)) break;
+        
+        place(index, std::move(heap[largest]));
+        index = largest;
     }
+    place(index, std::move(item));
+}
+
+// After the item at index changed: it moves up or down, never both
+void PriorityQueue::reposition(int index) {
+    if (heapifyUp(index) == index) {
+        heapifyDown(index);
+    }
+}
+
+// Floyd's method: sift down every internal node, last to first - O(n)
+void PriorityQueue::buildHeap() {
+    invalidateIndex();
+    if (heap.size() <= 1) return;
+    for (int i = parent(static_cast<int>(heap.size()) - 1); i >= 0; i--) {
+        heapifyDown(i);
+    }
+}
+
+PriorityQueue::PriorityQueue(std::vector<TodoItem> items) : heap(std::move(items)) {
+    buildHeap();
+}
+
+void PriorityQueue::pushAll(std::vector<TodoItem> items) {
+    if (heap.empty()) {
+        heap = std::move(items);
+    } else {
+        heap.insert(heap.end(), std::make_move_iterator(items.begin()),
+                    std::make_move_iterator(items.end()));
+    }
+    buildHeap();
+}
+
+std::vector<TodoItem> PriorityQueue::release() {
+    std::vector<TodoItem> items = std::move(heap);
+    heap.clear();
+    invalidateIndex();
+    return items;
 }
 
 void PriorityQueue::push(const TodoItem& item) {
     heap.push_back(item);
+    if (indexed) {
+        positions.insert(item.id, heap.size() - 1);
+    }
     heapifyUp(heap.size() - 1);
 }
 
@@ -37,11 +110,14 @@ TodoItem PriorityQueue::pop() {
         throw std::runtime_error("Priority queue is empty");
     }
     
-    TodoItem root = heap[0];
-    heap[0] = heap.back();
+    TodoItem root = std::move(heap[0]);
+    if (indexed) {
+        positions.erase(root.id);
+    }
+    TodoItem last = std::move(heap.back());
     heap.pop_back();
-    
     if (!heap.empty()) {
+        heap[0] = std::move(last);
         heapifyDown(0);
     }
     
@@ -64,123 +140,112 @@ TodoItem* PriorityQueue::linearSearch(int id) {
     return nullptr;
 }
 
-TodoItem* PriorityQueue::binarySearch(int id) {
-    // Create sorted copy for binary search
-    std::vector<TodoItem> sorted = heap;
-    std::sort(sorted.begin(), sorted.end(), 
-              [](const TodoItem& a, const TodoItem& b) {
-                  return a.id < b.id;
-              });
+// Every item not yet taken is below one already taken, so the next one is
+// always among the children of those taken
+std::vector<TodoItem> PriorityQueue::top(size_t k) const {
+    std::vector<TodoItem> next;
+    if (k == 0 || heap.empty()) return next;
     
-    int left = 0, right = sorted.size() - 1;
-    
-    while (left <= right) {
-        int mid = left + (right - left) / 2;
-        
-        if (sorted[mid].id == id) {
-            // Find in original heap
-            return linearSearch(id);
-        }
+    auto lower = [this](size_t a, size_t b) { return heap[a] < heap[b]; };
+    std::vector<size_t> frontier{0};
+    next.reserve(std::min(k, heap.size()));
+    while (!frontier.empty() && next.size() < k) {
+        std::pop_heap(frontier.begin(), frontier.end(), lower);
+        size_t index = frontier.back();
+        frontier.pop_back();
+        next.push_back(heap[index]);
         
-        if (sorted[mid].id < id) {
-            left = mid + 1;
-        } else {
-            right = mid - 1;
+        size_t first = ARITY * index + 1;
+        size_t last = std::min(first + ARITY, heap.size());
+        for (size_t child = first; child < last; child++) {
+            frontier.push_back(child);
+            std::push_heap(frontier.begin(), frontier.end(), lower);
         }
     }
-    
-    return nullptr;
+    return next;
 }
 
-TodoItem* PriorityQueue::findByTitle(const std::string& title) {
-    for (auto& item : heap) {
-        if (item.title.find(title) != std::string::npos) {
-            return &item;
-        }
+bool PriorityQueue::update(int id) {
+    ensureIndex();
+    size_t index = positions.find(id);
+    if (index == IdIndex::NPOS) {
+        return false;
     }
-    return nullptr;
+    reposition(static_cast<int>(index));
+    return true;
 }
 
-// Quick Sort Implementation
-void PriorityQueue::quickSortByPriority() {
-    if (heap.size() <= 1) return;
-    
-    // Convert to vector for sorting
-    std::vector<TodoItem> temp = heap;
-    heap.clear();
-    
-    std::sort(temp.begin(), temp.end(), 
-              [](const TodoItem& a, const TodoItem& b) {
-                  return a.priority > b.priority; // Descending
-              });
-    
-    for (const auto& item : temp) {
-        heap.push_back(item);
+bool PriorityQueue::update(const TodoItem& item) {
+    ensureIndex();
+    size_t index = positions.find(item.id);
+    if (index == IdIndex::NPOS) {
+        return false;
     }
+    heap[index] = item;
+    reposition(static_cast<int>(index));
+    return true;
 }
 
-// Merge Sort Implementation
-void PriorityQueue::mergeSort(int left, int right) {
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        mergeSort(left, mid);
-        mergeSort(mid + 1, right);
-        merge(left, mid, right);
+// The last item fills the hole and then moves whichever way it must
+bool PriorityQueue::erase(int id) {
+    ensureIndex();
+    size_t index = positions.find(id);
+    if (index == IdIndex::NPOS) {
+        return false;
+    }
+    positions.erase(id);
+    TodoItem last = std::move(heap.back());
+    heap.pop_back();
+    if (index < heap.size()) {
+        heap[index] = std::move(last);
+        reposition(static_cast<int>(index));
     }
+    return true;
 }
 
-void PriorityQueue::merge(int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-    
-    std::vector<TodoItem> L(n1), R(n2);
-    
-    for (int i = 0; i < n1; i++)
-        L[i] = heap[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = heap[mid + 1 + j];
-    
-    int i = 0, j = 0, k = left;
-    
-    while (i < n1 && j < n2) {
-        if (L[i].dueDate <= R[j].dueDate) {
-            heap[k] = L[i];
-            i++;
-        } else {
-            heap[k] = R[j];
-            j++;
+TodoItem* PriorityQueue::find(int id) {
+    ensureIndex();
+    size_t slot = positions.find(id);
+    return slot == IdIndex::NPOS ? nullptr : &heap[slot];
+}
+
+bool PriorityQueue::contains(int id) {
+    return find(id) != nullptr;
+}
+
+// Used to sort a copy of the heap on every call; the index makes that moot
+TodoItem* PriorityQueue::binarySearch(int id) {
+    return find(id);
+}
+
+TodoItem* PriorityQueue::findByTitle(const std::string& title) {
+    for (auto& item : heap) {
+        if (item.title.find(title) != std::string::npos) {
+            return &item;
         }
-        k++;
-    }
-    
-    while (i < n1) {
-        heap[k] = L[i];
-        i++;
-        k++;
-    }
-    
-    while (j < n2) {
-        heap[k] = R[j];
-        j++;
-        k++;
     }
+    return nullptr;
 }
 
-void PriorityQueue::mergeSortByDate() {
+// The reorders below sort a permutation with a linear-time sort, then move
+// each item once
+
+void PriorityQueue::sortByPriority() {
     if (heap.size() <= 1) return;
-    mergeSort(0, heap.size() - 1);
+    invalidateIndex();
+    SortSearch::applyOrder(heap, SortSearch::orderByPriority(heap));
 }
 
-// Bubble Sort Implementation
-void PriorityQueue::bubbleSortByStatus() {
-    int n = heap.size();
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            if (static_cast<int>(heap[j].status) > static_cast<int>(heap[j + 1].status)) {
-                std::swap(heap[j], heap[j + 1]);
-            }
-        }
-    }
+void PriorityQueue::sortByDueDate() {
+    if (heap.size() <= 1) return;
+    invalidateIndex();
+    SortSearch::applyOrder(heap, SortSearch::orderByDueDate(heap));
+}
+
+void PriorityQueue::sortByStatus() {
+    if (heap.size() <= 1) return;
+    invalidateIndex();
+    SortSearch::applyOrder(heap, SortSearch::orderByStatus(heap));
 }
 
 void PriorityQueue::compress() {
@@ -194,4 +259,5 @@ void PriorityQueue::compress() {
         });
     
     heap.erase(newEnd, heap.end());
+    invalidateIndex();
 }
\ No newline at end of file
@@ -2,21 +2,38 @@
 #define PRIORITYQUEUE_H
 
 #include "TodoItem.h"
+#include "IdIndex.h"
+#include <algorithm>
 #include <vector>
 
+// 4-ary max-heap: half the depth of a binary heap, and the four children
+// of a node are adjacent, so a sift-down reads one or two cache lines per
+// level. Items move through a hole instead of being swapped.
 class PriorityQueue {
 private:
+    static constexpr int ARITY = 4;
+    
     std::vector<TodoItem> heap;
     
+    // id -> heap position, built on the first lookup and then kept in step
+    // with every move; bulk reorders just drop it
+    IdIndex positions;
+    bool indexed = false;
+    
     // Heap operations
-    void heapifyUp(int index);
+    void place(int index, TodoItem&& item);
+    void invalidateIndex();
+    void ensureIndex();
+    int heapifyUp(int index);   // returns where the item ends up
     void heapifyDown(int index);
-    int parent(int index) { return (index - 1) / 2; }
-    int leftChild(int index) { return 2 * index + 1; }
-    int rightChild(int index) { return 2 * index + 2; }
+    void reposition(int index);
+    void buildHeap();
+    int parent(int index) { return (index - 1) / ARITY; }
+    int firstChild(int index) { return ARITY * index + 1; }
     
 public:
     PriorityQueue() = default;
+    explicit PriorityQueue(std::vector<TodoItem> items);
     
     // Core operations
     void push(const TodoItem& item);
@@ -25,27 +42,73 @@ public:
     bool isEmpty() const { return heap.empty(); }
     size_t size() const { return heap.size(); }
     
+    // The next k items pop() would return, in that order, without popping:
+    // a best-first walk from the root, O(k log k)
+    std::vector<TodoItem> top(size_t k) const;
+    // The k first items under any ordering (less(a, b): a comes first),
+    // best first; a bounded heap over the items, O(n log k)
+    template <typename Less>
+    std::vector<TodoItem> topK(size_t k, Less less) const;
+    
+    // Keyed operations - O(log n) through the position index; false if
+    // the id is not queued
+    bool update(int id);                 // after editing the item via find()
+    bool update(const TodoItem& item);   // replace the queued copy by id
+    bool erase(int id);
+    
+    // Bulk operations - O(n) via Floyd's bottom-up heapify
+    void pushAll(std::vector<TodoItem> items);
+    std::vector<TodoItem> release();
+    
+    // Underlying storage in heap order, for streaming serializers
+    const std::vector<TodoItem>& items() const { return heap; }
+    
     // Search operations
+    TodoItem* find(int id);         // O(1) through the position index
+    bool contains(int id);
     TodoItem* linearSearch(int id);
-    TodoItem* binarySearch(int id); // Only works on sorted vector
+    TodoItem* binarySearch(int id); // Same as find(); kept for existing callers
     TodoItem* findByTitle(const std::string& title);
     
-    // Sorting algorithms
-    void quickSortByPriority();
-    void mergeSortByDate();
-    void bubbleSortByStatus();
+    // Sorting: stable counting sort (priority, status) or radix sort (due
+    // day, no date first), O(n). Items are left in sorted order, not heap
+    // order; pushAll rebuilds the heap
+    void sortByPriority();
+    void sortByDueDate();
+    void sortByStatus();
+    // Old names, from when these were quick, merge and bubble sorts
+    [[deprecated("use sortByPriority")]] void quickSortByPriority() { sortByPriority(); }
+    [[deprecated("use sortByDueDate")]] void mergeSortByDate() { sortByDueDate(); }
+    [[deprecated("use sortByStatus")]] void bubbleSortByStatus() { sortByStatus(); }
     
     // Space optimization
     void compress(); // Remove completed items older than 30 days
+};
+
+template <typename Less>
+std::vector<TodoItem> PriorityQueue::topK(size_t k, Less less) const {
+    std::vector<TodoItem> best;
+    if (k == 0) return best;
     
-private:
-    // Quick sort helper
-    void quickSort(int low, int high);
-    int partition(int low, int high);
+    // Max-heap under less: its front is the worst item kept
+    auto before = [this, &less](size_t a, size_t b) { return less(heap[a], heap[b]); };
+    std::vector<size_t> kept;
+    kept.reserve(std::min(k, heap.size()));
+    for (size_t i = 0; i < heap.size(); i++) {
+        if (kept.size() < k) {
+            kept.push_back(i);
+            std::push_heap(kept.begin(), kept.end(), before);
+        } else if (before(i, kept.front())) {
+            std::pop_heap(kept.begin(), kept.end(), before);
+            kept.back() = i;
+            std::push_heap(kept.begin(), kept.end(), before);
+        }
+    }
+    std::sort_heap(kept.begin(), kept.end(), before);
     
-    // Merge sort helper
-    void mergeSort(int left, int right);
-    void merge(int left, int mid, int right);
-};
+    best.reserve(kept.size());
+    for (size_t i : kept) best.push_back(heap[i]);
+    return best;
+}
 
 #endif // PRIORITYQUEUE_H
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "Query.h"
+#include "DueDateIndex.h"
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+bool isTextField(QueryField field) {
+    return field == QueryField::TITLE || field == QueryField::DESCRIPTION;
+}
+
+// Lower case with spaces, '_' and '-' dropped, so "In Progress",
+// "in_progress" and "inprogress" compare equal
+std::string normalize(std::string_view text) {
+    std::string out;
+    for (char c : text) {
+        if (c == ' ' || c == '_' || c == '-') continue;
+        out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+bool parsePriorityValue(std::string_view text, int64_t& value) {
+    std::string key = normalize(text);
+    for (int p = static_cast<int>(Priority::LOW); p <= static_cast<int>(Priority::URGENT); p++) {
+        if (key == normalize(TodoItem::priorityName(static_cast<Priority>(p)))) {
+            value = p;
+            return true;
+        }
+    }
+    Priority priority;
+    if (!TodoItem::parsePriority(text, priority)) return false;
+    value = static_cast<int64_t>(priority);
+    return true;
+}
+
+bool parseStatusValue(std::string_view text, int64_t& value) {
+    std::string key = normalize(text);
+    for (int s = static_cast<int>(Status::PENDING); s <= static_cast<int>(Status::COMPLETED); s++) {
+        if (key == normalize(TodoItem::statusName(static_cast<Status>(s)))) {
+            value = s;
+            return true;
+        }
+    }
+    Status status;
+    if (!TodoItem::parseStatus(text, status)) return false;
+    value = static_cast<int64_t>(status);
+    return true;
+}
+
+bool parseField(std::string_view word, QueryField& field) {
+    std::string key = normalize(word);
+    if (key == "id") field = QueryField::ID;
+    else if (key == "title") field = QueryField::TITLE;
+    else if (key == "description" || key == "desc") field = QueryField::DESCRIPTION;
+    else if (key == "due" || key == "duedate") field = QueryField::DUE;
+    else if (key == "priority") field = QueryField::PRIORITY;
+    else if (key == "status") field = QueryField::STATUS;
+    else if (key == "text") field = QueryField::TEXT;
+    else return false;
+    return true;
+}
+
+// Splits the query text into words, operators and (quoted) values
+class Lexer {
+public:
+    explicit Lexer(std::string_view text) : text(text), pos(0) {}
+
+    bool atEnd() {
+        skipSpace();
+        return pos >= text.size();
+    }
+
+    // Letters, digits and '_'
+    std::string_view word() {
+        skipSpace();
+        size_t start = pos;
+        while (pos < text.size() &&
+               (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) {
+            pos++;
+        }
+        return text.substr(start, pos - start);
+    }
+
+    std::string_view peekWord() {
+        size_t start = pos;
+        std::string_view next = word();
+        pos = start;
+        return next;
+    }
+
+    bool op(QueryOp& op) {
+        skipSpace();
+        std::string_view rest = text.substr(pos);
+        struct Symbol { const char* text; QueryOp op; };
+        static const Symbol symbols[] = {
+            {"!=", QueryOp::NE}, {"<=", QueryOp::LE}, {">=", QueryOp::GE},
+            {"==", QueryOp::EQ}, {"!~", QueryOp::NOT_CONTAINS},
+            {"=", QueryOp::EQ}, {"<", QueryOp::LT}, {">", QueryOp::GT}, {"~", QueryOp::CONTAINS}
+        };
+        for (const Symbol& symbol : symbols) {
+            std::string_view s(symbol.text);
+            if (rest.substr(0, s.size()) == s) {
+                pos += s.size();
+                op = symbol.op;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // A quoted string ("..." with \" and \\ escapes) or a run of non-space
+    bool value(std::string& out) {
+        skipSpace();
+        out.clear();
+        if (pos < text.size() && text[pos] == '"') {
+            pos++;
+            while (pos < text.size() && text[pos] != '"') {
+                if (text[pos] == '\\' && pos + 1 < text.size()) pos++;
+                out += text[pos++];
+            }
+            if (pos >= text.size()) return false; // unterminated
+            pos++;
+            return true;
+        }
+        size_t start = pos;
+        while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+        out.assign(text.substr(start, pos - start));
+        return !out.empty();
+    }
+
+    size_t offset() const { return pos; }
+
+private:
+    std::string_view text;
+    size_t pos;
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+};
+
+} // namespace
+
+bool QueryPredicate::accepts(int64_t value) const {
+    switch (op) {
+        case QueryOp::EQ: return value == number;
+        case QueryOp::NE: return value != number;
+        case QueryOp::LT: return value < number;
+        case QueryOp::LE: return value <= number;
+        case QueryOp::GT: return value > number;
+        case QueryOp::GE: return value >= number;
+        default: return false;
+    }
+}
+
+bool QueryPredicate::range(int64_t& lo, int64_t& hi) const {
+    lo = INT64_MIN;
+    hi = INT64_MAX;
+    switch (op) {
+        case QueryOp::EQ: lo = hi = number; return true;
+        case QueryOp::LT: hi = number - 1; return true;
+        case QueryOp::LE: hi = number; return true;
+        case QueryOp::GT: lo = number + 1; return true;
+        case QueryOp::GE: lo = number; return true;
+        default: return false;
+    }
+}
+
+bool QueryPredicate::matches(const TodoItem& todo) const {
+    switch (field) {
+        case QueryField::ID: return accepts(todo.id);
+        case QueryField::PRIORITY: return accepts(static_cast<int64_t>(todo.priority));
+        case QueryField::STATUS: return accepts(static_cast<int64_t>(todo.status));
+        case QueryField::DUE: {
+            int32_t day = DueDateIndex::parseDay(todo.dueDate);
+            return day != DueDateIndex::NO_DATE && accepts(day);
+        }
+        case QueryField::TITLE:
+        case QueryField::DESCRIPTION: {
+            const std::string& value = field == QueryField::TITLE ? todo.title : todo.description;
+            switch (op) {
+                case QueryOp::EQ: return value == text;
+                case QueryOp::NE: return value != text;
+                case QueryOp::CONTAINS: return value.find(text) != std::string::npos;
+                case QueryOp::NOT_CONTAINS: return value.find(text) == std::string::npos;
+                default: return false;
+            }
+        }
+        case QueryField::TEXT:
+            return words.matches(todo.title, todo.description);
+    }
+    return false;
+}
+
+Query& Query::where(QueryField field, QueryOp op, int64_t number) {
+    QueryPredicate predicate{field, op, number, {}, {}};
+    predicates.push_back(std::move(predicate));
+    return *this;
+}
+
+Query& Query::where(QueryField field, QueryOp op, std::string text) {
+    QueryPredicate predicate{field, op, 0, std::move(text), {}};
+    if (field == QueryField::TEXT) predicate.words = TextQuery::parse(predicate.text);
+    predicates.push_back(std::move(predicate));
+    return *this;
+}
+
+Query& Query::where(QueryOp op, Priority priority) {
+    return where(QueryField::PRIORITY, op, static_cast<int64_t>(priority));
+}
+
+Query& Query::where(QueryOp op, Status status) {
+    return where(QueryField::STATUS, op, static_cast<int64_t>(status));
+}
+
+Query& Query::orderBy(QueryField field, bool descending) {
+    ordered = true;
+    orderField = field;
+    this->descending = descending;
+    return *this;
+}
+
+Query& Query::take(size_t count) {
+    limit = count;
+    return *this;
+}
+
+bool Query::matches(const TodoItem& todo) const {
+    for (const QueryPredicate& predicate : predicates) {
+        if (!predicate.matches(todo)) return false;
+    }
+    return true;
+}
+
+const char* Query::fieldName(QueryField field) {
+    switch (field) {
+        case QueryField::ID: return "id";
+        case QueryField::TITLE: return "title";
+        case QueryField::DESCRIPTION: return "description";
+        case QueryField::DUE: return "due";
+        case QueryField::PRIORITY: return "priority";
+        case QueryField::STATUS: return "status";
+        case QueryField::TEXT: return "text";
+        default: return "unknown";
+    }
+}
+
+bool Query::parse(std::string_view text, Query& query, std::string& error) {
+    query = Query();
+    Lexer lexer(text);
+    auto fail = [&](const std::string& message) {
+        error = message + " at offset " + std::to_string(lexer.offset());
+        return false;
+    };
+
+    while (!lexer.atEnd()) {
+        std::string_view word = lexer.word();
+        if (word.empty()) return fail("expected a field name");
+        std::string keyword = normalize(word);
+
+        if (keyword == "and") continue;
+
+        if (keyword == "order") {
+            if (normalize(lexer.word()) != "by") return fail("expected 'by' after 'order'");
+            QueryField field;
+            if (!parseField(lexer.word(), field)) return fail("unknown order field");
+            if (field == QueryField::TEXT) return fail("cannot order by text");
+            query.orderBy(field);
+            std::string direction = normalize(lexer.peekWord());
+            if (direction == "asc" || direction == "desc") {
+                lexer.word();
+                query.descending = direction == "desc";
+            }
+            continue;
+        }
+
+        if (keyword == "limit") {
+            std::string count;
+            if (!lexer.value(count)) return fail("expected a number after 'limit'");
+            char* end = nullptr;
+            unsigned long long value = std::strtoull(count.c_str(), &end, 10);
+            if (*end != '\0' || count[0] == '-') return fail("invalid limit '" + count + "'");
+            query.limit = static_cast<size_t>(value);
+            continue;
+        }
+
+        QueryField field;
+        if (!parseField(word, field)) return fail("unknown field '" + std::string(word) + "'");
+        QueryOp op;
+        if (!lexer.op(op)) return fail("expected an operator after '" + std::string(word) + "'");
+        std::string value;
+        if (!lexer.value(value)) return fail("missing or unterminated value");
+
+        bool textOp = op == QueryOp::CONTAINS || op == QueryOp::NOT_CONTAINS;
+        if (field == QueryField::TEXT) {
+            if (op != QueryOp::CONTAINS) return fail("text supports only ~");
+            query.where(field, op, value);
+            continue;
+        }
+        if (isTextField(field)) {
+            if (op != QueryOp::EQ && op != QueryOp::NE && !textOp) {
+                return fail(std::string(fieldName(field)) + " supports =, !=, ~ and !~");
+            }
+            query.where(field, op, value);
+            continue;
+        }
+        if (textOp) return fail(std::string(fieldName(field)) + " does not support ~");
+
+        int64_t number = 0;
+        switch (field) {
+            case QueryField::ID: {
+                char* end = nullptr;
+                long long id = std::strtoll(value.c_str(), &end, 10);
+                if (*end != '\0' || id < INT32_MIN || id > INT32_MAX) {
+                    return fail("invalid id '" + value + "'");
+                }
+                number = id;
+                break;
+            }
+            case QueryField::DUE:
+                number = normalize(value) == "today" ? DueDateIndex::today()
+                                                     : DueDateIndex::parseDay(value);
+                if (number == DueDateIndex::NO_DATE) {
+                    return fail("invalid date '" + value + "' (use YYYY-MM-DD or today)");
+                }
+                break;
+            case QueryField::PRIORITY:
+                if (!parsePriorityValue(value, number)) return fail("unknown priority '" + value + "'");
+                break;
+            case QueryField::STATUS:
+                if (!parseStatusValue(value, number)) return fail("unknown status '" + value + "'");
+                break;
+            default:
+                break;
+        }
+        query.where(field, op, number);
+    }
+    return true;
+}
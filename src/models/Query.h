@@ -0,0 +1,79 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include "TextIndex.h"
+#include "TodoItem.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class QueryField {
+    ID,
+    TITLE,
+    DESCRIPTION,
+    DUE,
+    PRIORITY,
+    STATUS,
+    TEXT // keywords in title or description (TextQuery syntax), ~ only
+};
+
+enum class QueryOp {
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    CONTAINS,     // ~, substring (title / description only)
+    NOT_CONTAINS  // !~
+};
+
+// One condition on one field. Id, due day, priority and status compare as
+// integers (due as a day number, priority LOW < ... < URGENT); todos
+// without a valid due date never match a due condition.
+struct QueryPredicate {
+    QueryField field;
+    QueryOp op;
+    int64_t number = 0; // id, due day or enum value
+    std::string text;   // title / description
+    TextQuery words;    // text
+
+    bool matches(const TodoItem& todo) const;
+    // Integer comparison against number
+    bool accepts(int64_t value) const;
+    // Closed interval accepted by an integer condition; false for != and
+    // the text operators
+    bool range(int64_t& lo, int64_t& hi) const;
+};
+
+// Conjunction of predicates with an optional ordering and limit. Build one
+// with where/orderBy/take, or parse the text form:
+//
+//   status!=completed priority>=high due<2025-07-01 title~"report"
+//   text~"budget OR invoice" order by due limit 20
+//
+// Values may be quoted; "and" between conditions is optional.
+struct Query {
+    std::vector<QueryPredicate> predicates;
+    bool ordered = false;
+    QueryField orderField = QueryField::ID;
+    bool descending = false;
+    size_t limit = 0; // 0 = all
+
+    Query& where(QueryField field, QueryOp op, int64_t number);
+    Query& where(QueryField field, QueryOp op, std::string text);
+    Query& where(QueryOp op, Priority priority);
+    Query& where(QueryOp op, Status status);
+    Query& orderBy(QueryField field, bool descending = false);
+    Query& take(size_t count);
+
+    bool matches(const TodoItem& todo) const;
+
+    // False with a message in error on a syntax error
+    static bool parse(std::string_view text, Query& query, std::string& error);
+    static const char* fieldName(QueryField field);
+};
+
+#endif // QUERY_H
@@ -0,0 +1,341 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// SWAR popcount: without -mpopcnt the builtin is a library call per word
+inline uint32_t popcount(uint64_t word) {
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<uint32_t>((word * 0x0101010101010101ull) >> 56);
+}
+
+} // namespace
+
+// --- Containers ---
+
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return (bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+bool RoaringBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (bits[low >> 6] & mask) return false;
+        bits[low >> 6] |= mask;
+        cardinality++;
+        return true;
+    }
+
+    // Appending in order (bulk loads, new slots) skips the search
+    if (array.empty() || array.back() < low) {
+        array.push_back(low);
+    } else {
+        auto it = std::lower_bound(array.begin(), array.end(), low);
+        if (*it == low) return false;
+        array.insert(it, low);
+    }
+    cardinality++;
+    if (cardinality > ARRAY_MAX) {
+        toBitmap();
+    }
+    return true;
+}
+
+bool RoaringBitmap::Container::remove(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(bits[low >> 6] & mask)) return false;
+        bits[low >> 6] &= ~mask;
+        cardinality--;
+        if (cardinality <= ARRAY_MAX) {
+            toArray();
+        }
+        return true;
+    }
+
+    auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it == array.end() || *it != low) return false;
+    array.erase(it);
+    cardinality--;
+    return true;
+}
+
+void RoaringBitmap::Container::toBitmap() {
+    bits.assign(WORDS, 0);
+    for (uint16_t low : array) {
+        bits[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    std::vector<uint16_t>().swap(array);
+}
+
+void RoaringBitmap::Container::toArray() {
+    array.clear();
+    array.reserve(cardinality);
+    for (size_t w = 0; w < WORDS; w++) {
+        uint64_t word = bits[w];
+        while (word) {
+            array.push_back(static_cast<uint16_t>(w * 64 + __builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+    std::vector<uint64_t>().swap(bits);
+}
+
+void RoaringBitmap::Container::normalize() {
+    if (isBitmap() && cardinality <= ARRAY_MAX) {
+        toArray();
+    } else if (!isBitmap() && cardinality > ARRAY_MAX) {
+        toBitmap();
+    }
+}
+
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+    Container out;
+    if (a.isBitmap() && b.isBitmap()) {
+        out.bits.resize(WORDS);
+        uint32_t count = 0;
+        for (size_t w = 0; w < WORDS; w++) {
+            out.bits[w] = a.bits[w] & b.bits[w];
+            count += popcount(out.bits[w]);
+        }
+        out.cardinality = count;
+        out.normalize();
+    } else if (a.isBitmap() || b.isBitmap()) {
+        // Probe the bitmap with each array value
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        for (uint16_t low : sparse.array) {
+            if (dense.contains(low)) out.array.push_back(low);
+        }
+        out.cardinality = static_cast<uint32_t>(out.array.size());
+    } else {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(out.array));
+        out.cardinality = static_cast<uint32_t>(out.array.size());
+    }
+    return out;
+}
+
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+    Container out;
+    if (a.isBitmap() || b.isBitmap()) {
+        out.bits.assign(WORDS, 0);
+        for (const Container* in : {&a, &b}) {
+            if (in->isBitmap()) {
+                for (size_t w = 0; w < WORDS; w++) out.bits[w] |= in->bits[w];
+            } else {
+                for (uint16_t low : in->array) out.bits[low >> 6] |= uint64_t(1) << (low & 63);
+            }
+        }
+        uint32_t count = 0;
+        for (uint64_t word : out.bits) count += popcount(word);
+        out.cardinality = count;
+    } else {
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(out.array));
+        out.cardinality = static_cast<uint32_t>(out.array.size());
+    }
+    out.normalize();
+    return out;
+}
+
+RoaringBitmap::Container RoaringBitmap::difference(const Container& a, const Container& b) {
+    Container out;
+    if (a.isBitmap()) {
+        out.bits = a.bits;
+        if (b.isBitmap()) {
+            for (size_t w = 0; w < WORDS; w++) out.bits[w] &= ~b.bits[w];
+        } else {
+            for (uint16_t low : b.array) out.bits[low >> 6] &= ~(uint64_t(1) << (low & 63));
+        }
+        uint32_t count = 0;
+        for (uint64_t word : out.bits) count += popcount(word);
+        out.cardinality = count;
+        out.normalize();
+    } else if (b.isBitmap()) {
+        for (uint16_t low : a.array) {
+            if (!b.contains(low)) out.array.push_back(low);
+        }
+        out.cardinality = static_cast<uint32_t>(out.array.size());
+    } else {
+        std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                            std::back_inserter(out.array));
+        out.cardinality = static_cast<uint32_t>(out.array.size());
+    }
+    return out;
+}
+
+size_t RoaringBitmap::intersectCount(const Container& a, const Container& b) {
+    size_t count = 0;
+    if (a.isBitmap() && b.isBitmap()) {
+        for (size_t w = 0; w < WORDS; w++) {
+            count += popcount(a.bits[w] & b.bits[w]);
+        }
+    } else if (a.isBitmap() || b.isBitmap()) {
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        for (uint16_t low : sparse.array) {
+            count += dense.contains(low);
+        }
+    } else {
+        auto i = a.array.begin();
+        auto j = b.array.begin();
+        while (i != a.array.end() && j != b.array.end()) {
+            if (*i < *j) {
+                ++i;
+            } else if (*j < *i) {
+                ++j;
+            } else {
+                count++;
+                ++i;
+                ++j;
+            }
+        }
+    }
+    return count;
+}
+
+// --- Bitmap ---
+
+size_t RoaringBitmap::lowerBound(uint16_t key) const {
+    // New slots usually land in the last container
+    if (!keys.empty() && keys.back() <= key) {
+        return keys.back() == key ? keys.size() - 1 : keys.size();
+    }
+    return std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+}
+
+bool RoaringBitmap::add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t i = lowerBound(key);
+    if (i == keys.size() || keys[i] != key) {
+        keys.insert(keys.begin() + i, key);
+        containers.insert(containers.begin() + i, Container());
+    }
+    if (!containers[i].add(static_cast<uint16_t>(value))) return false;
+    total++;
+    return true;
+}
+
+bool RoaringBitmap::remove(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t i = lowerBound(key);
+    if (i == keys.size() || keys[i] != key) return false;
+    if (!containers[i].remove(static_cast<uint16_t>(value))) return false;
+    total--;
+    if (containers[i].cardinality == 0) {
+        keys.erase(keys.begin() + i);
+        containers.erase(containers.begin() + i);
+    }
+    return true;
+}
+
+bool RoaringBitmap::contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t i = lowerBound(key);
+    return i < keys.size() && keys[i] == key && containers[i].contains(static_cast<uint16_t>(value));
+}
+
+void RoaringBitmap::clear() {
+    keys.clear();
+    containers.clear();
+    total = 0;
+}
+
+void RoaringBitmap::append(uint16_t key, Container&& container) {
+    if (container.cardinality == 0) return;
+    total += container.cardinality;
+    keys.push_back(key);
+    containers.push_back(std::move(container));
+}
+
+RoaringBitmap RoaringBitmap::intersect(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap out;
+    size_t i = 0, j = 0;
+    while (i < a.keys.size() && j < b.keys.size()) {
+        if (a.keys[i] < b.keys[j]) {
+            i++;
+        } else if (b.keys[j] < a.keys[i]) {
+            j++;
+        } else {
+            out.append(a.keys[i], intersect(a.containers[i], b.containers[j]));
+            i++;
+            j++;
+        }
+    }
+    return out;
+}
+
+RoaringBitmap RoaringBitmap::unite(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap out;
+    size_t i = 0, j = 0;
+    while (i < a.keys.size() || j < b.keys.size()) {
+        if (j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j])) {
+            out.append(a.keys[i], Container(a.containers[i]));
+            i++;
+        } else if (i == a.keys.size() || b.keys[j] < a.keys[i]) {
+            out.append(b.keys[j], Container(b.containers[j]));
+            j++;
+        } else {
+            out.append(a.keys[i], unite(a.containers[i], b.containers[j]));
+            i++;
+            j++;
+        }
+    }
+    return out;
+}
+
+RoaringBitmap RoaringBitmap::difference(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap out;
+    size_t j = 0;
+    for (size_t i = 0; i < a.keys.size(); i++) {
+        while (j < b.keys.size() && b.keys[j] < a.keys[i]) j++;
+        if (j < b.keys.size() && b.keys[j] == a.keys[i]) {
+            out.append(a.keys[i], difference(a.containers[i], b.containers[j]));
+        } else {
+            out.append(a.keys[i], Container(a.containers[i]));
+        }
+    }
+    return out;
+}
+
+size_t RoaringBitmap::intersectCount(const RoaringBitmap& a, const RoaringBitmap& b) {
+    size_t count = 0;
+    size_t i = 0, j = 0;
+    while (i < a.keys.size() && j < b.keys.size()) {
+        if (a.keys[i] < b.keys[j]) {
+            i++;
+        } else if (b.keys[j] < a.keys[i]) {
+            j++;
+        } else {
+            count += intersectCount(a.containers[i], b.containers[j]);
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+std::vector<uint32_t> RoaringBitmap::toVector(size_t limit) const {
+    std::vector<uint32_t> values;
+    values.reserve(limit ? std::min(limit, total) : total);
+    forEach([&](uint32_t value) {
+        values.push_back(value);
+        return limit == 0 || values.size() < limit;
+    });
+    return values;
+}
+
+size_t RoaringBitmap::memoryUsage() const {
+    size_t bytes = keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(Container);
+    for (const auto& container : containers) {
+        bytes += container.array.capacity() * sizeof(uint16_t) + container.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
@@ -0,0 +1,115 @@
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed set of 32-bit integers (slot numbers) in the roaring layout:
+// values are grouped by their high 16 bits, and each group of 65536 is
+// stored as a sorted array while it has at most 4096 members, or as a
+// 8 KB bitmap once it is denser. Set operations pick the cheapest
+// algorithm per pair of containers (merge, probe or 64-bit word logic).
+// Run containers are left out: slot numbers that share a priority or
+// status are interleaved with the others, so long runs are rare.
+class RoaringBitmap {
+public:
+    RoaringBitmap() : total(0) {}
+
+    bool add(uint32_t value);    // false if already present
+    bool remove(uint32_t value); // false if absent
+    bool contains(uint32_t value) const;
+    void clear();
+
+    size_t cardinality() const { return total; }
+    bool empty() const { return total == 0; }
+
+    static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b);  // a AND b
+    static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b);      // a OR b
+    static RoaringBitmap difference(const RoaringBitmap& a, const RoaringBitmap& b); // a AND NOT b
+
+    // Counts without building the result
+    static size_t intersectCount(const RoaringBitmap& a, const RoaringBitmap& b);
+    static size_t differenceCount(const RoaringBitmap& a, const RoaringBitmap& b) {
+        return a.cardinality() - intersectCount(a, b);
+    }
+
+    // Calls fn(value) in ascending order until it returns false
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        forEachFrom(0, fn);
+    }
+
+    // Same, starting at the first value >= first (resumable scans)
+    template <typename Fn>
+    void forEachFrom(uint32_t first, Fn fn) const {
+        size_t c = lowerBound(static_cast<uint16_t>(first >> 16));
+        uint32_t startLow = (c < keys.size() && keys[c] == (first >> 16)) ? (first & 0xFFFF) : 0;
+        for (; c < containers.size(); c++, startLow = 0) {
+            const Container& container = containers[c];
+            uint32_t high = static_cast<uint32_t>(keys[c]) << 16;
+            if (container.isBitmap()) {
+                size_t w = startLow / 64;
+                uint64_t word = container.bits[w] & (~uint64_t(0) << (startLow % 64));
+                while (true) {
+                    while (word) {
+                        uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(word));
+                        if (!fn(high | static_cast<uint32_t>(w * 64 + bit))) return;
+                        word &= word - 1;
+                    }
+                    if (++w == WORDS) break;
+                    word = container.bits[w];
+                }
+            } else {
+                auto it = startLow ? container.lowerBound(static_cast<uint16_t>(startLow))
+                                   : container.array.begin();
+                for (; it != container.array.end(); ++it) {
+                    if (!fn(high | *it)) return;
+                }
+            }
+        }
+    }
+
+    // Up to limit values in ascending order (0 = all)
+    std::vector<uint32_t> toVector(size_t limit = 0) const;
+
+    size_t memoryUsage() const;
+
+private:
+    static constexpr size_t ARRAY_MAX = 4096; // past this a bitmap is smaller
+    static constexpr size_t WORDS = 65536 / 64;
+
+    struct Container {
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array; // sorted, while cardinality <= ARRAY_MAX
+        std::vector<uint64_t> bits;  // WORDS words once converted
+
+        bool isBitmap() const { return !bits.empty(); }
+        bool contains(uint16_t low) const;
+        std::vector<uint16_t>::const_iterator lowerBound(uint16_t low) const {
+            return std::lower_bound(array.begin(), array.end(), low);
+        }
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        void toBitmap();
+        void toArray();
+        // Switch representation after a bulk operation
+        void normalize();
+    };
+
+    std::vector<uint16_t> keys; // sorted high halves
+    std::vector<Container> containers;
+    size_t total;
+
+    // Index of key, or where it would be inserted
+    size_t lowerBound(uint16_t key) const;
+    void append(uint16_t key, Container&& container);
+
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container difference(const Container& a, const Container& b);
+    static size_t intersectCount(const Container& a, const Container& b);
+};
+
+#endif // ROARINGBITMAP_H
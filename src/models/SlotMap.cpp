@@ -0,0 +1,114 @@
+#include "SlotMap.h"
+
+SlotMap::SlotMap(std::initializer_list<TodoItem> items) : SlotMap() {
+    reserve(items.size());
+    for (const auto& item : items) {
+        insert(item);
+    }
+}
+
+TodoHandle SlotMap::insert(TodoItem item) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(generations.size());
+        if ((slot & (CHUNK_SIZE - 1)) == 0) {
+            chunks.emplace_back(new TodoItem[CHUNK_SIZE]);
+        }
+        generations.push_back(0);
+    }
+
+    at(slot) = std::move(item);
+    generations[slot]++; // even -> odd: live
+    live++;
+
+    TodoHandle handle{slot, generations[slot]};
+    order.push_back(handle);
+    return handle;
+}
+
+bool SlotMap::erase(TodoHandle handle) {
+    if (!contains(handle)) return false;
+
+    at(handle.slot) = TodoItem(); // release the strings now
+    generations[handle.slot]++;   // odd -> even: free, old handles go stale
+    freeSlots.push_back(handle.slot);
+    live--;
+
+    // Compact once stale handles make up half the order: O(1) amortized
+    stale++;
+    if (stale * 2 > order.size()) {
+        compact();
+    }
+    return true;
+}
+
+void SlotMap::compact() {
+    if (stale == 0) return;
+    order.erase(std::remove_if(order.begin(), order.end(),
+                               [this](TodoHandle handle) { return !contains(handle); }),
+                order.end());
+    stale = 0;
+}
+
+const std::vector<TodoHandle>& SlotMap::handles() {
+    compact();
+    return order;
+}
+
+void SlotMap::setOrder(std::vector<TodoHandle>&& handles) {
+    order = std::move(handles);
+    stale = 0;
+}
+
+void SlotMap::assign(std::vector<TodoItem>&& items) {
+    clear();
+    reserve(items.size());
+    for (auto& item : items) {
+        insert(std::move(item));
+    }
+    items.clear();
+}
+
+std::vector<TodoItem> SlotMap::release() {
+    std::vector<TodoItem> items;
+    items.reserve(live);
+    for (auto& item : *this) {
+        items.push_back(std::move(item));
+    }
+    clear();
+    return items;
+}
+
+std::vector<TodoItem> SlotMap::toVector() const {
+    std::vector<TodoItem> items;
+    items.reserve(live);
+    for (const auto& item : *this) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+// Slots keep counting generations across clear(), so handles taken before
+// a clear never match what is stored afterwards
+void SlotMap::clear() {
+    freeSlots.clear();
+    for (size_t slot = generations.size(); slot-- > 0;) {
+        if (generations[slot] & 1) {
+            at(static_cast<uint32_t>(slot)) = TodoItem();
+            generations[slot]++;
+        }
+        freeSlots.push_back(static_cast<uint32_t>(slot));
+    }
+    order.clear();
+    live = 0;
+    stale = 0;
+}
+
+void SlotMap::reserve(size_t count) {
+    generations.reserve(count);
+    order.reserve(count);
+    chunks.reserve((count + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
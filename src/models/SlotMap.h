@@ -0,0 +1,147 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include "TodoItem.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// Stable reference to a todo in a SlotMap. The generation changes when the
+// slot is freed, so a handle to an erased todo never resolves to whatever
+// reuses its slot.
+struct TodoHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const TodoHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const TodoHandle& other) const { return !(*this == other); }
+};
+
+// Todo storage that never moves a live item. Items sit in fixed-size chunks
+// addressed by slot number; freed slots are reused through a free list.
+// Display order is a separate vector of handles, so sorting shuffles 8-byte
+// handles instead of whole todos, and erase just leaves a stale handle that
+// is skipped and compacted away later.
+class SlotMap {
+public:
+    static constexpr size_t CHUNK_BITS = 12;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS; // 4096 items
+
+    // Walks live items in display order
+    template <typename Map, typename Item>
+    class Iterator {
+    private:
+        Map* map;
+        size_t pos;
+
+        void skipStale() {
+            while (pos < map->order.size() && !map->contains(map->order[pos])) pos++;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TodoItem;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Item*;
+        using reference = Item&;
+
+        Iterator(Map* map, size_t pos) : map(map), pos(pos) { skipStale(); }
+
+        reference operator*() const { return map->at(map->order[pos].slot); }
+        pointer operator->() const { return &**this; }
+        Iterator& operator++() {
+            pos++;
+            skipStale();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return pos == other.pos; }
+        bool operator!=(const Iterator& other) const { return pos != other.pos; }
+
+        TodoHandle handle() const { return map->order[pos]; }
+    };
+
+    using iterator = Iterator<SlotMap, TodoItem>;
+    using const_iterator = Iterator<const SlotMap, const TodoItem>;
+
+    SlotMap() : live(0), stale(0) {}
+    SlotMap(std::initializer_list<TodoItem> items);
+
+    SlotMap(SlotMap&&) = default;
+    SlotMap& operator=(SlotMap&&) = default;
+
+    // O(1); the item goes to the end of the display order
+    TodoHandle insert(TodoItem item);
+    // O(1) amortized; false if the handle is stale
+    bool erase(TodoHandle handle);
+
+    bool contains(TodoHandle handle) const {
+        return handle.slot < generations.size() && generations[handle.slot] == handle.generation;
+    }
+    TodoItem* get(TodoHandle handle) { return contains(handle) ? &at(handle.slot) : nullptr; }
+    const TodoItem* get(TodoHandle handle) const {
+        return contains(handle) ? &at(handle.slot) : nullptr;
+    }
+    // Whether a slot currently holds an item (slots come from an index)
+    bool isLive(uint32_t slot) const {
+        return slot < generations.size() && (generations[slot] & 1) != 0;
+    }
+    // Handle for a slot that is known to be live (e.g. from an index)
+    TodoHandle handleAt(uint32_t slot) const { return TodoHandle{slot, generations[slot]}; }
+    // Direct slot access for indexes keyed by slot number
+    TodoItem& at(uint32_t slot) { return chunks[slot >> CHUNK_BITS][slot & (CHUNK_SIZE - 1)]; }
+    const TodoItem& at(uint32_t slot) const {
+        return chunks[slot >> CHUNK_BITS][slot & (CHUNK_SIZE - 1)];
+    }
+
+    size_t size() const { return live; }
+    bool empty() const { return live == 0; }
+    // Slots ever allocated; every live slot number is below this
+    size_t capacity() const { return generations.size(); }
+
+    // Live handles in display order
+    const std::vector<TodoHandle>& handles();
+
+    // Reorder the display order only; items stay where they are
+    template <typename Less>
+    void sort(Less less) {
+        compact();
+        std::sort(order.begin(), order.end(), [this, &less](TodoHandle a, TodoHandle b) {
+            return less(at(a.slot), at(b.slot));
+        });
+    }
+
+    // Replace the display order with an ordering computed elsewhere (e.g.
+    // from an index); it must list every live handle exactly once
+    void setOrder(std::vector<TodoHandle>&& handles);
+
+    // Bulk replace / drain, in display order
+    void assign(std::vector<TodoItem>&& items);
+    std::vector<TodoItem> release();
+    std::vector<TodoItem> toVector() const;
+    void clear();
+    void reserve(size_t count);
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, order.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, order.size()); }
+
+private:
+    std::vector<std::unique_ptr<TodoItem[]>> chunks;
+    std::vector<uint32_t> generations; // odd = live, even = free
+    std::vector<uint32_t> freeSlots;
+    std::vector<TodoHandle> order;
+    size_t live;
+    size_t stale; // erased handles still in order
+
+    // Drop stale handles from the display order
+    void compact();
+};
+
+#endif // SLOTMAP_H
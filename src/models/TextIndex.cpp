@@ -0,0 +1,401 @@
+#include "TextIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+struct TermCount {
+    std::string term;
+    uint32_t title = 0;
+    uint32_t description = 0;
+};
+
+// Distinct words of a todo with their counts per field
+std::vector<TermCount> countTerms(std::string_view title, std::string_view description,
+                                  uint32_t& titleLength, uint32_t& descriptionLength) {
+    std::vector<std::string> titleWords, descriptionWords;
+    TextIndex::tokenize(title, titleWords);
+    TextIndex::tokenize(description, descriptionWords);
+    titleLength = static_cast<uint32_t>(titleWords.size());
+    descriptionLength = static_cast<uint32_t>(descriptionWords.size());
+
+    std::vector<std::pair<std::string, bool>> words; // (word, in title)
+    words.reserve(titleWords.size() + descriptionWords.size());
+    for (auto& word : titleWords) words.emplace_back(std::move(word), true);
+    for (auto& word : descriptionWords) words.emplace_back(std::move(word), false);
+    std::sort(words.begin(), words.end());
+
+    std::vector<TermCount> counts;
+    for (auto& [word, inTitle] : words) {
+        if (counts.empty() || counts.back().term != word) {
+            counts.emplace_back();
+            counts.back().term = std::move(word);
+        }
+        (inTitle ? counts.back().title : counts.back().description)++;
+    }
+    return counts;
+}
+
+// Next word of text at or after pos, lower-cased into word; false at the end
+bool nextWord(std::string_view text, size_t& pos, std::string& word) {
+    auto isWordByte = [](unsigned char byte) { return std::isalnum(byte) || byte >= 0x80; };
+    while (pos < text.size() && !isWordByte(static_cast<unsigned char>(text[pos]))) pos++;
+    if (pos == text.size()) return false;
+    word.clear();
+    while (pos < text.size() && isWordByte(static_cast<unsigned char>(text[pos]))) {
+        word += static_cast<char>(std::tolower(static_cast<unsigned char>(text[pos++])));
+    }
+    return true;
+}
+
+// Whether the words of phrase appear back to back in text. Restarts from
+// the word after each partial match's start, so "a a b" finds "a b".
+bool containsPhrase(std::string_view text, const std::vector<std::string>& phrase) {
+    if (phrase.empty()) return true;
+    std::string word;
+    size_t start = 0;
+    while (nextWord(text, start, word)) {
+        if (word != phrase[0]) continue;
+        size_t pos = start;
+        size_t matched = 1;
+        while (matched < phrase.size() && nextWord(text, pos, word) && word == phrase[matched]) matched++;
+        if (matched == phrase.size()) return true;
+    }
+    return false;
+}
+
+bool phrasesMatch(const TextQuery::Clause& clause, std::string_view title, std::string_view description) {
+    for (const auto& phrase : clause.phrases) {
+        if (!containsPhrase(title, phrase) && !containsPhrase(description, phrase)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TextQuery TextQuery::parse(std::string_view text) {
+    TextQuery query;
+    Clause current;
+    auto endClause = [&]() {
+        if (!current.terms.empty()) query.clauses.push_back(std::move(current));
+        current = Clause();
+    };
+    auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+
+    std::vector<std::string> words;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (isSpace(text[i])) {
+            i++;
+            continue;
+        }
+        if (text[i] == '|') {
+            endClause();
+            i++;
+            continue;
+        }
+
+        size_t end;
+        std::string_view token;
+        if (text[i] == '"') {
+            end = text.find('"', i + 1);
+            if (end == std::string_view::npos) end = text.size();
+            token = text.substr(i + 1, end - i - 1);
+            i = std::min(end + 1, text.size());
+        } else {
+            end = i;
+            while (end < text.size() && !isSpace(text[end]) && text[end] != '"' && text[end] != '|') end++;
+            token = text.substr(i, end - i);
+            i = end;
+            if (token == "OR") {
+                endClause();
+                continue;
+            }
+            if (token == "AND") continue;
+        }
+
+        // A quoted phrase, or a word that splits in two (e-mail), must
+        // match as a sequence
+        TextIndex::tokenize(token, words);
+        if (words.size() > 1) current.phrases.push_back(words);
+        current.terms.insert(current.terms.end(), words.begin(), words.end());
+    }
+    endClause();
+    return query;
+}
+
+bool TextQuery::matches(std::string_view title, std::string_view description) const {
+    std::vector<std::string> titleWords, descriptionWords;
+    TextIndex::tokenize(title, titleWords);
+    TextIndex::tokenize(description, descriptionWords);
+    auto has = [](const std::vector<std::string>& words, const std::string& term) {
+        return std::find(words.begin(), words.end(), term) != words.end();
+    };
+
+    for (const Clause& clause : clauses) {
+        bool all = std::all_of(clause.terms.begin(), clause.terms.end(), [&](const std::string& term) {
+            return has(titleWords, term) || has(descriptionWords, term);
+        });
+        if (all && phrasesMatch(clause, title, description)) return true;
+    }
+    return false;
+}
+
+void TextIndex::tokenize(std::string_view text, std::vector<std::string>& tokens) {
+    tokens.clear();
+    std::string current;
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (std::isalnum(byte) || byte >= 0x80) {
+            current += static_cast<char>(std::tolower(byte));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(std::move(current));
+}
+
+void TextIndex::insert(uint32_t slot, std::string_view title, std::string_view description) {
+    if (slot >= docs.size()) docs.resize(slot + 1);
+    uint32_t titleLength, descriptionLength;
+    std::vector<TermCount> counts = countTerms(title, description, titleLength, descriptionLength);
+
+    Document& doc = docs[slot];
+    doc.version++;
+    doc.live = true;
+    doc.titleLength = static_cast<uint16_t>(std::min<uint32_t>(titleLength, UINT16_MAX));
+    doc.descriptionLength = static_cast<uint16_t>(std::min<uint32_t>(descriptionLength, UINT16_MAX));
+    liveDocs++;
+    totalLength += TITLE_WEIGHT * doc.titleLength + doc.descriptionLength;
+
+    uint32_t version = doc.version & VERSION_MASK;
+    for (TermCount& count : counts) {
+        auto entry = dictionary.emplace(std::move(count.term), static_cast<uint32_t>(lists.size()));
+        if (entry.second) lists.emplace_back();
+        PostingList& list = lists[entry.first->second];
+
+        Posting posting{slot, version << 8 | std::min<uint32_t>(count.title, 15) << 4 |
+                                  std::min<uint32_t>(count.description, 15)};
+        if (list.run.empty() || list.run.back().slot < slot) {
+            list.run.push_back(posting);
+        } else {
+            auto at = std::upper_bound(list.pending.begin(), list.pending.end(), slot,
+                                       [](uint32_t s, const Posting& p) { return s < p.slot; });
+            list.pending.insert(at, posting);
+            size_t threshold = std::max(MIN_PENDING, static_cast<size_t>(std::sqrt(double(list.run.size()))));
+            if (list.pending.size() > threshold) merge(list);
+        }
+        list.df++;
+        livePostings++;
+    }
+}
+
+void TextIndex::remove(uint32_t slot, std::string_view title, std::string_view description) {
+    if (slot >= docs.size() || !docs[slot].live) return;
+    uint32_t titleLength, descriptionLength;
+    for (const TermCount& count : countTerms(title, description, titleLength, descriptionLength)) {
+        auto entry = dictionary.find(count.term);
+        if (entry == dictionary.end() || lists[entry->second].df == 0) continue;
+        lists[entry->second].df--;
+        livePostings--;
+        stalePostings++;
+    }
+
+    Document& doc = docs[slot];
+    doc.live = false;
+    liveDocs--;
+    totalLength -= TITLE_WEIGHT * doc.titleLength + doc.descriptionLength;
+    compactIfStale();
+}
+
+void TextIndex::clear() {
+    dictionary.clear();
+    lists.clear();
+    docs.clear();
+    liveDocs = 0;
+    totalLength = 0;
+    livePostings = 0;
+    stalePostings = 0;
+}
+
+size_t TextIndex::documentFrequency(std::string_view term) const {
+    const PostingList* list = find(term);
+    return list ? list->df : 0;
+}
+
+const TextIndex::PostingList* TextIndex::find(std::string_view term) const {
+    auto entry = dictionary.find(std::string(term));
+    return entry == dictionary.end() ? nullptr : &lists[entry->second];
+}
+
+const TextIndex::Posting* TextIndex::probe(const PostingList& list, uint32_t slot, size_t& from) const {
+    auto bySlot = [](const Posting& p, uint32_t s) { return p.slot < s; };
+    // Gallop: probes rise, so the answer is usually a few entries ahead
+    const std::vector<Posting>& run = list.run;
+    size_t step = 1;
+    while (from + step < run.size() && run[from + step].slot < slot) step *= 2;
+    auto it = std::lower_bound(run.begin() + std::min(from, run.size()),
+                               run.begin() + std::min(from + step + 1, run.size()), slot, bySlot);
+    from = static_cast<size_t>(it - run.begin());
+    if (it != run.end() && it->slot == slot && valid(*it)) return &*it;
+    // An edited todo can have a stale entry in run and the live one here
+    for (it = std::lower_bound(list.pending.begin(), list.pending.end(), slot, bySlot);
+         it != list.pending.end() && it->slot == slot; ++it) {
+        if (valid(*it)) return &*it;
+    }
+    return nullptr;
+}
+
+float TextIndex::score(const Posting& posting, float idf, float averageLength) const {
+    const Document& doc = docs[posting.slot];
+    float tf = static_cast<float>(TITLE_WEIGHT * posting.titleTf() + posting.descriptionTf());
+    float length = static_cast<float>(TITLE_WEIGHT * doc.titleLength + doc.descriptionLength);
+    return idf * tf * (K1 + 1) / (tf + K1 * (1 - B + B * length / averageLength));
+}
+
+template <typename Fn>
+void TextIndex::forEachClauseMatch(const TextQuery::Clause& clause, Fn fn) const {
+    std::vector<const PostingList*> terms;
+    for (const std::string& term : clause.terms) {
+        const PostingList* list = find(term);
+        if (!list || list->df == 0) return; // a missing word: no match
+        terms.push_back(list);
+    }
+    if (terms.empty()) return;
+
+    // Walk the rarest word's list and probe the others
+    size_t driver = 0;
+    for (size_t i = 1; i < terms.size(); i++) {
+        if (terms[i]->df < terms[driver]->df) driver = i;
+    }
+    std::vector<const Posting*> postings(terms.size());
+    std::vector<size_t> positions(terms.size(), 0);
+    forEachPosting(*terms[driver], [&](const Posting& posting) {
+        for (size_t i = 0; i < terms.size(); i++) {
+            postings[i] = i == driver ? &posting : probe(*terms[i], posting.slot, positions[i]);
+            if (!postings[i]) return;
+        }
+        fn(posting.slot, postings);
+    });
+}
+
+std::vector<std::pair<uint32_t, float>> TextIndex::search(const TextQuery& query, const SlotMap& storage,
+                                                          size_t limit) const {
+    using Hit = std::pair<uint32_t, float>;
+    // Best first; ties by slot
+    auto better = [](const Hit& a, const Hit& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    std::vector<Hit> hits;
+    if (liveDocs == 0) return hits;
+
+    // Bounded heap with the worst kept hit at the front
+    auto offer = [&](const Hit& hit) {
+        if (limit == 0 || hits.size() < limit) {
+            hits.push_back(hit);
+            if (limit != 0 && hits.size() == limit) std::make_heap(hits.begin(), hits.end(), better);
+        } else if (better(hit, hits.front())) {
+            std::pop_heap(hits.begin(), hits.end(), better);
+            hits.back() = hit;
+            std::push_heap(hits.begin(), hits.end(), better);
+        }
+    };
+
+    float averageLength = std::max(1.0f, static_cast<float>(totalLength) / static_cast<float>(liveDocs));
+    float n = static_cast<float>(liveDocs);
+    // Each clause yields hits in slot order; a todo matching several
+    // clauses scores the sum, found by merging the sorted lists
+    std::vector<Hit> merged, clauseHits, combined;
+    for (const TextQuery::Clause& clause : query.clauses) {
+        std::vector<float> idfs;
+        for (const std::string& term : clause.terms) {
+            const PostingList* list = find(term);
+            float df = list ? static_cast<float>(list->df) : 0.0f;
+            idfs.push_back(std::log(1.0f + (n - df + 0.5f) / (df + 0.5f)));
+        }
+
+        clauseHits.clear();
+        forEachClauseMatch(clause, [&](uint32_t slot, const std::vector<const Posting*>& postings) {
+            if (!clause.phrases.empty()) {
+                const TodoItem& todo = storage.at(slot);
+                if (!phrasesMatch(clause, todo.title, todo.description)) return;
+            }
+            float total = 0;
+            for (size_t i = 0; i < postings.size(); i++) total += score(*postings[i], idfs[i], averageLength);
+            if (query.clauses.size() == 1) offer(Hit(slot, total));
+            else clauseHits.emplace_back(slot, total);
+        });
+        if (query.clauses.size() == 1) break;
+
+        combined.clear();
+        size_t a = 0, b = 0;
+        while (a < merged.size() || b < clauseHits.size()) {
+            if (b == clauseHits.size() || (a < merged.size() && merged[a].first < clauseHits[b].first)) {
+                combined.push_back(merged[a++]);
+            } else if (a == merged.size() || clauseHits[b].first < merged[a].first) {
+                combined.push_back(clauseHits[b++]);
+            } else {
+                combined.emplace_back(merged[a].first, merged[a].second + clauseHits[b].second);
+                a++;
+                b++;
+            }
+        }
+        merged.swap(combined);
+    }
+    for (const Hit& hit : merged) offer(hit);
+
+    std::sort(hits.begin(), hits.end(), better);
+    return hits;
+}
+
+RoaringBitmap TextIndex::candidates(const TextQuery& query) const {
+    RoaringBitmap slots;
+    for (const TextQuery::Clause& clause : query.clauses) {
+        forEachClauseMatch(clause, [&](uint32_t slot, const std::vector<const Posting*>&) {
+            slots.add(slot);
+        });
+    }
+    return slots;
+}
+
+size_t TextIndex::estimate(const TextQuery& query) const {
+    size_t total = 0;
+    for (const TextQuery::Clause& clause : query.clauses) {
+        size_t rarest = SIZE_MAX;
+        for (const std::string& term : clause.terms) {
+            rarest = std::min(rarest, documentFrequency(term));
+        }
+        if (rarest != SIZE_MAX) total += rarest;
+    }
+    return std::min(total, liveDocs);
+}
+
+void TextIndex::merge(PostingList& list) {
+    std::vector<Posting> merged;
+    merged.reserve(list.df);
+    forEachPosting(list, [&](const Posting& posting) { merged.push_back(posting); });
+    size_t dropped = list.run.size() + list.pending.size() - merged.size();
+    stalePostings -= std::min(stalePostings, dropped);
+    list.run.swap(merged);
+    list.pending.clear();
+}
+
+void TextIndex::compactIfStale() {
+    if (stalePostings <= livePostings || stalePostings < MIN_PENDING) return;
+
+    std::unordered_map<std::string, uint32_t> keptTerms;
+    std::vector<PostingList> keptLists;
+    for (auto& [term, index] : dictionary) {
+        PostingList& list = lists[index];
+        if (list.df == 0) continue;
+        merge(list);
+        keptTerms.emplace(term, static_cast<uint32_t>(keptLists.size()));
+        keptLists.push_back(std::move(list));
+    }
+    dictionary.swap(keptTerms);
+    lists.swap(keptLists);
+    stalePostings = 0;
+}
@@ -0,0 +1,134 @@
+#ifndef TEXTINDEX_H
+#define TEXTINDEX_H
+
+#include "RoaringBitmap.h"
+#include "SlotMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Parsed keyword query: an OR of clauses, each clause an AND of words and
+// quoted phrases. "quarterly report" OR "annual review" budget
+struct TextQuery {
+    struct Clause {
+        std::vector<std::string> terms;                // every word, phrase words included
+        std::vector<std::vector<std::string>> phrases; // must appear consecutively
+    };
+    std::vector<Clause> clauses;
+
+    // Words are ANDed, OR (or |) separates clauses, "..." is a phrase
+    static TextQuery parse(std::string_view text);
+    bool empty() const { return clauses.empty(); }
+    // Checks one todo without the index
+    bool matches(std::string_view title, std::string_view description) const;
+};
+
+// Inverted index over the words of each todo's title and description,
+// keyed by slot. Each term has a posting list sorted by slot; most
+// postings are appended in order, and the few that land earlier (reused
+// slots, edited todos) go to a small sorted side list that is merged in
+// once it holds about sqrt(n) entries. Removing a todo only bumps its
+// version, so its old postings go stale and are dropped at the next merge
+// or compaction. Ranking is BM25 with title words weighted double.
+class TextIndex {
+public:
+    // Lower-cased runs of letters and digits; bytes >= 0x80 count as
+    // letters, so UTF-8 words stay whole
+    static void tokenize(std::string_view text, std::vector<std::string>& tokens);
+
+    TextIndex() : liveDocs(0), totalLength(0), livePostings(0), stalePostings(0) {}
+
+    void insert(uint32_t slot, std::string_view title, std::string_view description);
+    // Pass the text that was indexed for the slot
+    void remove(uint32_t slot, std::string_view title, std::string_view description);
+    void clear();
+
+    size_t documentCount() const { return liveDocs; }
+    size_t termCount() const { return dictionary.size(); }
+    // Todos containing the word
+    size_t documentFrequency(std::string_view term) const;
+
+    // Up to limit matching slots with their BM25 scores, best first
+    // (0 = all). Phrases are verified against the stored todos.
+    std::vector<std::pair<uint32_t, float>> search(const TextQuery& query, const SlotMap& storage,
+                                                   size_t limit = 0) const;
+    // Slots holding every word of some clause (phrases not verified)
+    RoaringBitmap candidates(const TextQuery& query) const;
+    // Upper bound on candidates(query).cardinality(), from document
+    // frequencies alone
+    size_t estimate(const TextQuery& query) const;
+
+private:
+    static constexpr float K1 = 1.2f;
+    static constexpr float B = 0.75f;
+    static constexpr uint32_t TITLE_WEIGHT = 2;
+    static constexpr uint32_t VERSION_MASK = 0xFFFFFF;
+    static constexpr size_t MIN_PENDING = 64;
+
+    struct Posting {
+        uint32_t slot;
+        uint32_t packed; // version << 8 | title tf << 4 | description tf
+
+        uint32_t version() const { return packed >> 8; }
+        uint32_t titleTf() const { return (packed >> 4) & 0xF; }
+        uint32_t descriptionTf() const { return packed & 0xF; }
+    };
+
+    struct PostingList {
+        std::vector<Posting> run;     // sorted by slot
+        std::vector<Posting> pending; // sorted by slot, earlier than run.back()
+        uint32_t df = 0;              // live documents with the term
+    };
+
+    struct Document {
+        uint32_t version = 0;
+        uint16_t titleLength = 0; // words
+        uint16_t descriptionLength = 0;
+        bool live = false;
+    };
+
+    std::unordered_map<std::string, uint32_t> dictionary; // term -> lists index
+    std::vector<PostingList> lists;
+    std::vector<Document> docs; // by slot
+    size_t liveDocs;
+    uint64_t totalLength; // weighted words over live documents
+    size_t livePostings;
+    size_t stalePostings;
+
+    bool valid(const Posting& posting) const {
+        const Document& doc = docs[posting.slot];
+        return doc.live && (doc.version & VERSION_MASK) == posting.version();
+    }
+    const PostingList* find(std::string_view term) const;
+    // The live posting for slot, or nullptr. Probes must come in rising
+    // slot order; from is the run position to gallop from, and advances
+    const Posting* probe(const PostingList& list, uint32_t slot, size_t& from) const;
+    float score(const Posting& posting, float idf, float averageLength) const;
+
+    // Calls fn(posting) for live postings in slot order
+    template <typename Fn>
+    void forEachPosting(const PostingList& list, Fn fn) const {
+        size_t r = 0, p = 0;
+        while (r < list.run.size() || p < list.pending.size()) {
+            bool fromRun = p == list.pending.size() ||
+                           (r < list.run.size() && list.run[r].slot < list.pending[p].slot);
+            const Posting& posting = fromRun ? list.run[r++] : list.pending[p++];
+            if (valid(posting)) fn(posting);
+        }
+    }
+
+    // Calls fn(slot, postings) for each slot holding every term of the
+    // clause; postings[i] belongs to the clause's i-th term
+    template <typename Fn>
+    void forEachClauseMatch(const TextQuery::Clause& clause, Fn fn) const;
+
+    void merge(PostingList& list);
+    // Drop every stale posting once they outnumber the live ones
+    void compactIfStale();
+};
+
+#endif // TEXTINDEX_H
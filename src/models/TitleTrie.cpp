@@ -0,0 +1,310 @@
+#include "TitleTrie.h"
+#include "TopKCache.h"
+#include <algorithm>
+
+namespace {
+
+inline bool isSpace(unsigned char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+} // namespace
+
+std::string TitleTrie::normalize(std::string_view title) {
+    std::string out;
+    out.reserve(title.size());
+    bool space = false;
+    for (char ch : title) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (isSpace(c)) {
+            space = !out.empty();
+            continue;
+        }
+        if (space) out.push_back(' ');
+        space = false;
+        out.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : ch);
+    }
+    return out;
+}
+
+uint64_t TitleTrie::rankKey(uint32_t slot, Priority priority, int32_t dueDay) {
+    return TopKCache::urgencyKey(slot, priority, dueDay);
+}
+
+void TitleTrie::clear() {
+    nodes.assign(1, Node());
+    freeNodes.clear();
+    entries.clear();
+    labels.clear();
+    garbage = 0;
+    titles = 0;
+    seed = 0x9E3779B9;
+}
+
+void TitleTrie::insert(uint32_t slot, std::string_view title, Priority priority, int32_t dueDay) {
+    remove(slot);
+    uint32_t node = findOrCreate(normalize(title));
+    if (slot >= entries.size()) entries.resize(slot + 1);
+
+    uint64_t key = rankKey(slot, priority, dueDay);
+    entries[slot].key = key;
+    entries[slot].node = node;
+    heapInsert(nodes[node], slot);
+    titles++;
+
+    for (uint32_t at = node; at != NONE && key < nodes[at].best; at = nodes[at].parent) {
+        nodes[at].best = key;
+    }
+}
+
+void TitleTrie::remove(uint32_t slot) {
+    if (slot >= entries.size() || entries[slot].node == NONE) return;
+    uint32_t node = entries[slot].node;
+    uint64_t key = entries[slot].key;
+    heapErase(nodes[node], slot);
+    entries[slot].node = NONE;
+    titles--;
+
+    // Only nodes whose best was this key need a new one; above the first
+    // node with a better best, nothing changes
+    for (uint32_t at = prune(node); at != NONE; at = nodes[at].parent) {
+        if (nodes[at].best < key) break;
+        nodes[at].best = subtreeBest(nodes[at]);
+    }
+}
+
+std::vector<uint32_t> TitleTrie::complete(std::string_view prefix, size_t k) const {
+    std::vector<uint32_t> slots;
+    if (k == 0) return slots;
+
+    std::string key = normalize(prefix);
+    if (!key.empty() && isSpace(static_cast<unsigned char>(prefix.back()))) key.push_back(' ');
+
+    // Descend to the node whose subtree holds every completion; the prefix
+    // may end partway along its edge
+    uint32_t at = 0;
+    size_t pos = 0;
+    while (pos < key.size()) {
+        uint32_t child = findChild(at, static_cast<unsigned char>(key[pos]));
+        if (child == NONE) return slots;
+        std::string_view edge = label(nodes[child]);
+        size_t length = std::min(edge.size(), key.size() - pos);
+        if (edge.compare(0, length, std::string_view(key).substr(pos, length)) != 0) return slots;
+        at = child;
+        pos += length;
+    }
+    if (nodes[at].best == EMPTY) return slots;
+
+    // Best-first over whole subtrees (slot NONE) and single titles
+    struct Item {
+        uint64_t key;
+        uint32_t node;
+        uint32_t slot;
+    };
+    auto worse = [](const Item& a, const Item& b) { return a.key > b.key; };
+    std::vector<Item> frontier;
+    auto push = [&](const Item& item) {
+        frontier.push_back(item);
+        std::push_heap(frontier.begin(), frontier.end(), worse);
+    };
+    push({nodes[at].best, at, NONE});
+    while (!frontier.empty() && slots.size() < k) {
+        std::pop_heap(frontier.begin(), frontier.end(), worse);
+        Item item = frontier.back();
+        frontier.pop_back();
+
+        if (item.slot == NONE) {
+            const Node& node = nodes[item.node];
+            if (node.ends != NONE) push({entries[node.ends].key, item.node, node.ends});
+            for (uint32_t child = node.firstChild; child != NONE; child = nodes[child].nextSibling) {
+                push({nodes[child].best, child, NONE});
+            }
+            continue;
+        }
+
+        slots.push_back(item.slot);
+        const Entry& entry = entries[item.slot];
+        if (entry.left != NONE) push({entries[entry.left].key, item.node, entry.left});
+        if (entry.right != NONE) push({entries[entry.right].key, item.node, entry.right});
+    }
+    return slots;
+}
+
+size_t TitleTrie::memoryUsage() const {
+    return nodes.capacity() * sizeof(Node) + freeNodes.capacity() * sizeof(uint32_t) +
+           entries.capacity() * sizeof(Entry) + labels.capacity();
+}
+
+void TitleTrie::setLabel(uint32_t node, std::string_view text) {
+    nodes[node].labelStart = static_cast<uint32_t>(labels.size());
+    nodes[node].labelLength = static_cast<uint32_t>(text.size());
+    labels.append(text.data(), text.size());
+}
+
+void TitleTrie::compactLabels() {
+    if (garbage < 4096 || garbage < labels.size() / 2) return;
+    std::string packed;
+    packed.reserve(labels.size() - garbage);
+    for (Node& node : nodes) {
+        if (node.labelLength == 0) continue;
+        uint32_t start = static_cast<uint32_t>(packed.size());
+        packed.append(labels, node.labelStart, node.labelLength);
+        node.labelStart = start;
+    }
+    labels.swap(packed);
+    garbage = 0;
+}
+
+uint32_t TitleTrie::newNode() {
+    if (!freeNodes.empty()) {
+        uint32_t node = freeNodes.back();
+        freeNodes.pop_back();
+        return node;
+    }
+    nodes.emplace_back();
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void TitleTrie::freeNode(uint32_t node) {
+    garbage += nodes[node].labelLength;
+    nodes[node] = Node();
+    freeNodes.push_back(node);
+}
+
+uint32_t TitleTrie::findChild(uint32_t node, unsigned char first) const {
+    for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        unsigned char c = static_cast<unsigned char>(labels[nodes[child].labelStart]);
+        if (c == first) return child;
+        if (c > first) break;
+    }
+    return NONE;
+}
+
+void TitleTrie::addChild(uint32_t parent, uint32_t child) {
+    unsigned char first = static_cast<unsigned char>(labels[nodes[child].labelStart]);
+    uint32_t* link = &nodes[parent].firstChild;
+    while (*link != NONE && static_cast<unsigned char>(labels[nodes[*link].labelStart]) < first) {
+        link = &nodes[*link].nextSibling;
+    }
+    nodes[child].nextSibling = *link;
+    nodes[child].parent = parent;
+    *link = child;
+}
+
+void TitleTrie::replaceChild(uint32_t parent, uint32_t child, uint32_t replacement) {
+    uint32_t* link = &nodes[parent].firstChild;
+    while (*link != child) link = &nodes[*link].nextSibling;
+    if (replacement == NONE) {
+        *link = nodes[child].nextSibling;
+        return;
+    }
+    nodes[replacement].nextSibling = nodes[child].nextSibling;
+    nodes[replacement].parent = parent;
+    *link = replacement;
+}
+
+uint32_t TitleTrie::findOrCreate(std::string_view title) {
+    uint32_t at = 0;
+    size_t pos = 0;
+    while (pos < title.size()) {
+        uint32_t child = findChild(at, static_cast<unsigned char>(title[pos]));
+        if (child == NONE) {
+            uint32_t leaf = newNode();
+            setLabel(leaf, title.substr(pos));
+            addChild(at, leaf);
+            return leaf;
+        }
+
+        std::string_view edge = label(nodes[child]);
+        size_t limit = std::min(edge.size(), title.size() - pos);
+        size_t common = 1; // the first byte matched in findChild
+        while (common < limit && edge[common] == title[pos + common]) common++;
+        if (common < edge.size()) {
+            // Split the edge; both halves keep pointing into the same bytes
+            uint32_t middle = newNode();
+            Node& upper = nodes[middle];
+            Node& lower = nodes[child];
+            upper.labelStart = lower.labelStart;
+            upper.labelLength = static_cast<uint32_t>(common);
+            lower.labelStart += static_cast<uint32_t>(common);
+            lower.labelLength -= static_cast<uint32_t>(common);
+            upper.best = lower.best;
+            replaceChild(at, child, middle);
+            upper.firstChild = child;
+            lower.nextSibling = NONE;
+            lower.parent = middle;
+            child = middle;
+        }
+        at = child;
+        pos += common;
+    }
+    return at;
+}
+
+uint32_t TitleTrie::prune(uint32_t node) {
+    uint32_t at = node;
+    while (at != 0 && nodes[at].ends == NONE && nodes[at].firstChild == NONE) {
+        uint32_t parent = nodes[at].parent;
+        replaceChild(parent, at, NONE);
+        freeNode(at);
+        at = parent;
+    }
+    uint32_t only = nodes[at].firstChild;
+    if (at != 0 && nodes[at].ends == NONE && only != NONE && nodes[only].nextSibling == NONE) {
+        // The child's new label is this edge followed by its own
+        uint32_t start = static_cast<uint32_t>(labels.size());
+        labels.append(labels, nodes[at].labelStart, nodes[at].labelLength);
+        labels.append(labels, nodes[only].labelStart, nodes[only].labelLength);
+        garbage += nodes[only].labelLength;
+        nodes[only].labelStart = start;
+        nodes[only].labelLength += nodes[at].labelLength;
+        replaceChild(nodes[at].parent, at, only);
+        freeNode(at);
+        at = only;
+    }
+    compactLabels();
+    return at;
+}
+
+uint32_t TitleTrie::meld(uint32_t a, uint32_t b) {
+    if (a == NONE) return b;
+    if (b == NONE) return a;
+    if (entries[b].key < entries[a].key) std::swap(a, b);
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    uint32_t& side = (seed & 1) ? entries[a].left : entries[a].right;
+    side = meld(side, b);
+    entries[side].up = a;
+    return a;
+}
+
+void TitleTrie::heapInsert(Node& node, uint32_t slot) {
+    Entry& entry = entries[slot];
+    entry.left = entry.right = entry.up = NONE;
+    node.ends = meld(node.ends, slot);
+    entries[node.ends].up = NONE;
+}
+
+// The entry's two subheaps meld into its place; their keys are no smaller
+// than its own, so the heap order above is kept
+void TitleTrie::heapErase(Node& node, uint32_t slot) {
+    Entry& entry = entries[slot];
+    uint32_t merged = meld(entry.left, entry.right);
+    if (merged != NONE) entries[merged].up = entry.up;
+    if (entry.up == NONE) {
+        node.ends = merged;
+    } else {
+        Entry& up = entries[entry.up];
+        (up.left == slot ? up.left : up.right) = merged;
+    }
+    entry.left = entry.right = entry.up = NONE;
+}
+
+uint64_t TitleTrie::subtreeBest(const Node& node) const {
+    uint64_t best = node.ends == NONE ? EMPTY : entries[node.ends].key;
+    for (uint32_t child = node.firstChild; child != NONE; child = nodes[child].nextSibling) {
+        best = std::min(best, nodes[child].best);
+    }
+    return best;
+}
@@ -0,0 +1,105 @@
+#ifndef TITLETRIE_H
+#define TITLETRIE_H
+
+#include "TodoItem.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Radix trie over normalized titles for autocomplete, keyed by slot.
+// Every node caches the best rank in its subtree, and the titles ending at
+// a node form a heap, so the top-k completions of a prefix come from a
+// best-first walk that only opens the nodes it returns from:
+// O(prefix + k * fanout * log k), however many titles match. Rank is
+// priority (urgent first), then due day (no due date last), then slot.
+//
+// Nodes are 32 bytes: edge labels live in one shared byte pool, children
+// are a sibling list, and each title's heap links sit in a per-slot entry.
+class TitleTrie {
+public:
+    // Lower-cased ASCII with whitespace runs collapsed to one space and
+    // trimmed at both ends
+    static std::string normalize(std::string_view title);
+
+    TitleTrie() { clear(); }
+
+    void insert(uint32_t slot, std::string_view title, Priority priority, int32_t dueDay);
+    // No-op if the slot is not in the trie
+    void remove(uint32_t slot);
+    void clear();
+
+    size_t size() const { return titles; }
+    size_t nodeCount() const { return nodes.size() - freeNodes.size(); }
+
+    // Up to k slots whose normalized title starts with the normalized
+    // prefix, best first. A trailing space in the prefix is kept, so
+    // "team " does not complete to "teamwork".
+    std::vector<uint32_t> complete(std::string_view prefix, size_t k = 10) const;
+
+    size_t memoryUsage() const;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+
+    struct Node {
+        uint32_t labelStart = 0;  // edge from the parent, in labels
+        uint32_t labelLength = 0;
+        uint32_t parent = NONE;
+        uint32_t firstChild = NONE;  // children in label order
+        uint32_t nextSibling = NONE;
+        uint32_t ends = NONE;        // heap root among the titles ending here
+        uint64_t best = EMPTY;       // smallest key in the subtree
+    };
+
+    // One title; left / right / up link it into its node's heap
+    struct Entry {
+        uint64_t key = EMPTY;
+        uint32_t node = NONE; // NONE if the slot is not in the trie
+        uint32_t left = NONE;
+        uint32_t right = NONE;
+        uint32_t up = NONE;
+    };
+
+    std::vector<Node> nodes; // nodes[0] is the root
+    std::vector<uint32_t> freeNodes;
+    std::vector<Entry> entries; // by slot
+    std::string labels;
+    size_t garbage; // label bytes no node refers to
+    size_t titles;
+    uint32_t seed;  // meld coin flips
+
+    // priority (2 bits) | biased due day (30 bits) | slot (32 bits)
+    static uint64_t rankKey(uint32_t slot, Priority priority, int32_t dueDay);
+    static uint32_t slotOf(uint64_t key) { return static_cast<uint32_t>(key); }
+
+    std::string_view label(const Node& node) const {
+        return std::string_view(labels.data() + node.labelStart, node.labelLength);
+    }
+    void setLabel(uint32_t node, std::string_view text);
+    // Rewrite the pool once most of it is garbage
+    void compactLabels();
+
+    uint32_t newNode();
+    void freeNode(uint32_t node);
+    // Child whose label starts with first, or NONE
+    uint32_t findChild(uint32_t node, unsigned char first) const;
+    void addChild(uint32_t parent, uint32_t child);
+    // Put replacement (or nothing, for NONE) where child was
+    void replaceChild(uint32_t parent, uint32_t child, uint32_t replacement);
+    // Node for the normalized title, splitting edges as needed
+    uint32_t findOrCreate(std::string_view title);
+    // Drop a node left without titles or children, and fold a node left
+    // with one child into it; returns the lowest node still on the path
+    uint32_t prune(uint32_t node);
+
+    // Randomized meldable heap over entries, O(log n) expected
+    uint32_t meld(uint32_t a, uint32_t b);
+    void heapInsert(Node& node, uint32_t slot);
+    void heapErase(Node& node, uint32_t slot);
+    uint64_t subtreeBest(const Node& node) const;
+};
+
+#endif // TITLETRIE_H
@@ -27,6 +27,18 @@ bool TodoItem::operator>(const TodoItem& other) const {
 }
 
 std::string TodoItem::priorityToString() const {
+    return priorityName(priority);
+}
+
+std::string TodoItem::statusToString() const {
+    return statusName(status);
+}
+
+int TodoItem::daysRemaining() const {
+    return daysUntil(dueDate);
+}
+
+const char* TodoItem::priorityName(Priority priority) {
     switch (priority) {
         case Priority::LOW: return "Low";
         case Priority::MEDIUM: return "Medium";
@@ -36,7 +48,7 @@ std::string TodoItem::priorityToString() const {
     }
 }
 
-std::string TodoItem::statusToString() const {
+const char* TodoItem::statusName(Status status) {
     switch (status) {
         case Status::PENDING: return "Pending";
         case Status::IN_PROGRESS: return "In Progress";
@@ -45,11 +57,33 @@ std::string TodoItem::statusToString() const {
     }
 }
 
-int TodoItem::daysRemaining() const {
+bool TodoItem::parsePriority(std::string_view text, Priority& priority) {
+    for (int p = static_cast<int>(Priority::LOW); p <= static_cast<int>(Priority::URGENT); p++) {
+        if (text == priorityName(static_cast<Priority>(p)) ||
+            (text.size() == 1 && text[0] == '0' + p)) {
+            priority = static_cast<Priority>(p);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TodoItem::parseStatus(std::string_view text, Status& status) {
+    for (int s = static_cast<int>(Status::PENDING); s <= static_cast<int>(Status::COMPLETED); s++) {
+        if (text == statusName(static_cast<Status>(s)) ||
+            (text.size() == 1 && text[0] == '0' + s)) {
+            status = static_cast<Status>(s);
+            return true;
+        }
+    }
+    return false;
+}
+
+int TodoItem::daysUntil(std::string_view dueDate) {
     if (dueDate.empty()) return -1;
     
     std::tm due_tm = {};
-    std::istringstream ss(dueDate);
+    std::istringstream ss{std::string(dueDate)};
     ss >> std::get_time(&due_tm, "%Y-%m-%d");
     
     if (ss.fail()) return -1;
@@ -2,6 +2,7 @@
 #define TODOITEM_H
 
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <ctime>
 #include <sstream>
@@ -52,6 +53,15 @@ struct TodoItem {
     
     // Calculate time remaining
     int daysRemaining() const;
+    
+    // Shared with TodoItemView
+    static const char* priorityName(Priority priority);
+    static const char* statusName(Status status);
+    static int daysUntil(std::string_view dueDate);
+    
+    // Inverse of priorityName / statusName (also accepts the enum number)
+    static bool parsePriority(std::string_view text, Priority& priority);
+    static bool parseStatus(std::string_view text, Status& status);
 };
 
 #endif // TODOITEM_H
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include "TodoItemView.h"
+
+TodoItem TodoItemView::materialize() const {
+    TodoItem item;
+    item.id = id;
+    item.title.assign(title.data(), title.size());
+    item.description.assign(description.data(), description.size());
+    item.dueDate.assign(dueDate.data(), dueDate.size());
+    item.priority = priority;
+    item.status = status;
+    item.createdAt = createdAt;
+    item.updatedAt = updatedAt;
+    return item;
+}
@@ -0,0 +1,38 @@
+#ifndef TODOITEMVIEW_H
+#define TODOITEMVIEW_H
+
+#include "TodoItem.h"
+#include <string_view>
+
+// Read-only, non-owning view of a todo. String fields point into storage
+// owned by someone else (usually a MappedStore), so a view is only valid
+// while that storage is alive. Call materialize() before mutating.
+struct TodoItemView {
+    int id;
+    std::string_view title;
+    std::string_view description;
+    std::string_view dueDate;
+    Priority priority;
+    Status status;
+    std::time_t createdAt;
+    std::time_t updatedAt;
+
+    TodoItemView() : id(0), priority(Priority::MEDIUM), status(Status::PENDING),
+                     createdAt(0), updatedAt(0) {}
+
+    // View over an owning item (the item must outlive the view); explicit
+    // so a view never binds to a temporary by accident
+    explicit TodoItemView(const TodoItem& item)
+        : id(item.id), title(item.title), description(item.description),
+          dueDate(item.dueDate), priority(item.priority), status(item.status),
+          createdAt(item.createdAt), updatedAt(item.updatedAt) {}
+
+    std::string priorityToString() const { return TodoItem::priorityName(priority); }
+    std::string statusToString() const { return TodoItem::statusName(status); }
+    int daysRemaining() const { return TodoItem::daysUntil(dueDate); }
+
+    // Copy into an owning TodoItem
+    TodoItem materialize() const;
+};
+
+#endif // TODOITEMVIEW_H
@@ -0,0 +1,47 @@
+#include "TopKCache.h"
+#include "DueDateIndex.h"
+#include <algorithm>
+
+uint64_t TopKCache::urgencyKey(uint32_t slot, Priority priority, int32_t dueDay) {
+    const int64_t bias = int64_t(1) << 29;
+    const uint64_t lastDay = (uint64_t(1) << 30) - 1;
+    uint64_t day = dueDay == DueDateIndex::NO_DATE
+                       ? lastDay
+                       : static_cast<uint64_t>(std::clamp<int64_t>(int64_t(dueDay) + bias, 0,
+                                                                   int64_t(lastDay) - 1));
+    uint64_t urgency = 3 - static_cast<uint64_t>(priority);
+    return urgency << 62 | day << 32 | slot;
+}
+
+void TopKCache::assign(std::vector<Row> selected, bool whole) {
+    capacity = std::max(capacity, std::min(selected.size(), MAX_CAPACITY));
+    if (selected.size() > capacity) {
+        selected.resize(capacity);
+        whole = false;
+    }
+    rows = std::move(selected);
+    complete = whole;
+}
+
+void TopKCache::offer(uint32_t slot, uint64_t key) {
+    // Worse than every row held: it can only matter if nothing is missing
+    if (!complete && (rows.empty() || key > rows.back().key)) return;
+
+    auto at = std::lower_bound(rows.begin(), rows.end(), key,
+                               [](const Row& row, uint64_t k) { return row.key < k; });
+    rows.insert(at, Row{key, slot});
+    if (rows.size() > capacity) {
+        rows.pop_back();
+        complete = false;
+    }
+}
+
+void TopKCache::remove(uint32_t slot) {
+    auto at = std::find_if(rows.begin(), rows.end(), [slot](const Row& row) { return row.slot == slot; });
+    if (at != rows.end()) rows.erase(at);
+}
+
+void TopKCache::clear() {
+    rows.clear();
+    complete = false;
+}
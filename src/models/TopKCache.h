@@ -0,0 +1,54 @@
+#ifndef TOPKCACHE_H
+#define TOPKCACHE_H
+
+#include "TodoItem.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The best few rows of a ranking, kept exact under single-row changes so
+// repeated "next N" reads cost O(N) instead of a new selection.
+//
+// The rows held are always exactly the best rows.size() of the ranking:
+// dropping one keeps that true, and a new row only has to be placed if
+// it beats the last one held. Once removals shrink the cache below a read
+// it has to be refilled from a full selection (see assign). Keys order
+// ascending and must be unique, e.g. with the slot in the low bits.
+class TopKCache {
+public:
+    struct Row {
+        uint64_t key;
+        uint32_t slot;
+    };
+
+    // Most urgent priority first, then earliest due day (none last), then
+    // slot; the same order as the title trie's completions
+    static uint64_t urgencyKey(uint32_t slot, Priority priority, int32_t dueDay);
+
+    static constexpr size_t MAX_CAPACITY = 1024;
+
+    explicit TopKCache(size_t capacity = 32) : capacity(capacity), complete(false) {}
+
+    // Whether the first k rows are known (all rows, if fewer than k exist)
+    bool covers(size_t k) const { return complete || k <= rows.size(); }
+    const std::vector<Row>& best() const { return rows; }
+
+    // Replace the contents with the best rows of a fresh selection, sorted;
+    // whole = they are every row there is. The capacity grows to the
+    // largest selection seen, up to MAX_CAPACITY
+    void assign(std::vector<Row> selected, bool whole);
+    // A row joined the ranking / left it; O(capacity)
+    void offer(uint32_t slot, uint64_t key);
+    void remove(uint32_t slot);
+    // Forget everything, e.g. after a bulk reload
+    void clear();
+
+    size_t limit() const { return capacity; }
+
+private:
+    std::vector<Row> rows; // ascending by key
+    size_t capacity;
+    bool complete;
+};
+
+#endif // TOPKCACHE_H
@@ -0,0 +1,72 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+
+std::vector<uint32_t> TrigramIndex::trigrams(std::string_view text) {
+    std::vector<uint32_t> grams;
+    if (text.size() < GRAM) return grams;
+    grams.reserve(text.size() - GRAM + 1);
+    for (size_t i = 0; i + GRAM <= text.size(); i++) {
+        grams.push_back(uint32_t(static_cast<unsigned char>(text[i])) << 16 |
+                        uint32_t(static_cast<unsigned char>(text[i + 1])) << 8 |
+                        uint32_t(static_cast<unsigned char>(text[i + 2])));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+void TrigramIndex::insert(uint32_t slot, std::string_view text) {
+    for (uint32_t gram : trigrams(text)) {
+        postings[gram].add(slot);
+    }
+}
+
+void TrigramIndex::remove(uint32_t slot, std::string_view text) {
+    for (uint32_t gram : trigrams(text)) {
+        auto entry = postings.find(gram);
+        if (entry == postings.end()) continue;
+        entry->second.remove(slot);
+        if (entry->second.empty()) postings.erase(entry);
+    }
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+}
+
+bool TrigramIndex::candidates(std::string_view pattern, RoaringBitmap& slots) const {
+    slots.clear();
+    if (pattern.size() < GRAM) return false;
+
+    std::vector<const RoaringBitmap*> lists;
+    for (uint32_t gram : trigrams(pattern)) {
+        auto entry = postings.find(gram);
+        if (entry == postings.end()) return true; // no slot has it
+        lists.push_back(&entry->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const RoaringBitmap* a, const RoaringBitmap* b) {
+        return a->cardinality() < b->cardinality();
+    });
+
+    slots = *lists[0];
+    for (size_t i = 1; i < lists.size() && slots.cardinality() > SMALL_ENOUGH; i++) {
+        slots = RoaringBitmap::intersect(slots, *lists[i]);
+    }
+    return true;
+}
+
+size_t TrigramIndex::estimate(std::string_view pattern) const {
+    if (pattern.size() < GRAM) return SIZE_MAX;
+    size_t rarest = SIZE_MAX;
+    for (uint32_t gram : trigrams(pattern)) {
+        auto entry = postings.find(gram);
+        rarest = std::min(rarest, entry == postings.end() ? 0 : entry->second.cardinality());
+    }
+    return rarest;
+}
+
+size_t TrigramIndex::memoryUsage() const {
+    size_t bytes = postings.size() * (sizeof(uint32_t) + sizeof(RoaringBitmap));
+    for (const auto& entry : postings) bytes += entry.second.memoryUsage();
+    return bytes;
+}
@@ -0,0 +1,49 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include "RoaringBitmap.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Substring index over one text field, keyed by slot. Every run of three
+// bytes in the text maps to a bitmap of the slots containing it; a pattern
+// can only occur in slots holding all of its trigrams, so intersecting
+// those bitmaps (rarest first) leaves a small candidate set that the caller
+// verifies with std::string::find. Matching is byte-exact, like find.
+class TrigramIndex {
+public:
+    static constexpr size_t GRAM = 3;
+
+    TrigramIndex() = default;
+
+    void insert(uint32_t slot, std::string_view text);
+    // Pass the text that was indexed for the slot
+    void remove(uint32_t slot, std::string_view text);
+    void clear();
+
+    size_t trigramCount() const { return postings.size(); }
+
+    // Slots that may contain pattern. False when the pattern is shorter
+    // than a trigram and cannot be narrowed; the caller scans instead.
+    bool candidates(std::string_view pattern, RoaringBitmap& slots) const;
+    // Upper bound on the candidate count (rarest trigram), or SIZE_MAX for
+    // a short pattern
+    size_t estimate(std::string_view pattern) const;
+
+    size_t memoryUsage() const;
+
+private:
+    // Stop intersecting once this few candidates remain; verifying them
+    // is cheaper than more bitmap work
+    static constexpr size_t SMALL_ENOUGH = 32;
+
+    std::unordered_map<uint32_t, RoaringBitmap> postings;
+
+    // Distinct trigrams of text
+    static std::vector<uint32_t> trigrams(std::string_view text);
+};
+
+#endif // TRIGRAMINDEX_H
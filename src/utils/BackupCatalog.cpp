@@ -0,0 +1,183 @@
+#include "BackupCatalog.h"
+#include "FileHandler.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+const char BackupCatalog::MAGIC[16] = "TODO_CATALOG_V1";
+
+BackupCatalog::BackupCatalog(const std::string& directory)
+    : directory(directory), loaded(false) {}
+
+bool BackupCatalog::ensureDirectory() const {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    return !ec;
+}
+
+bool BackupCatalog::load() {
+    if (loaded) return true;
+    entries.clear();
+
+    std::ifstream file(catalogPath(), std::ios::binary);
+    if (!file.is_open()) {
+        loaded = true; // no catalog yet
+        return true;
+    }
+
+    char magic[sizeof(MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "⚠️  Invalid backup catalog: " << catalogPath() << std::endl;
+        return false;
+    }
+
+    BackupEntry entry;
+    while (file.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+        entries.push_back(entry);
+    }
+
+    loaded = true;
+    return true;
+}
+
+const std::vector<BackupEntry>& BackupCatalog::list() {
+    load();
+    return entries;
+}
+
+const BackupEntry* BackupCatalog::find(uint32_t sequence) {
+    load();
+    if (sequence == 0 || sequence > entries.size()) return nullptr;
+    return &entries[sequence - 1];
+}
+
+const BackupEntry* BackupCatalog::latest() {
+    load();
+    return entries.empty() ? nullptr : &entries.back();
+}
+
+const BackupEntry* BackupCatalog::latestFull() {
+    load();
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        if (it->kind == static_cast<uint8_t>(BackupKind::FULL)) return &*it;
+    }
+    return nullptr;
+}
+
+bool BackupCatalog::append(BackupEntry& entry) {
+    if (!load() || !ensureDirectory()) return false;
+
+    bool isNew = entries.empty() && !std::filesystem::exists(catalogPath());
+    std::FILE* file = std::fopen(catalogPath().c_str(), "ab");
+    if (!file) {
+        std::cerr << "❌ Could not open backup catalog: " << catalogPath() << std::endl;
+        return false;
+    }
+
+    entry.sequence = static_cast<uint32_t>(entries.size() + 1);
+    if (entry.kind == static_cast<uint8_t>(BackupKind::FULL)) {
+        entry.baseSequence = entry.sequence;
+        entry.parentSequence = 0;
+    }
+
+    bool ok = true;
+    if (isNew) {
+        ok = std::fwrite(MAGIC, sizeof(MAGIC), 1, file) == 1;
+    }
+    ok = ok && std::fwrite(&entry, sizeof(entry), 1, file) == 1;
+    ok = FileHandler::syncFile(file) && ok;
+    std::fclose(file);
+
+    if (ok) {
+        entries.push_back(entry);
+    }
+    return ok;
+}
+
+std::vector<BackupEntry> BackupCatalog::chainFor(uint32_t sequence) {
+    std::vector<BackupEntry> chain;
+    const BackupEntry* entry = find(sequence);
+
+    // Walk parent links back to the full backup, then reverse
+    while (entry) {
+        chain.push_back(*entry);
+        if (entry->kind == static_cast<uint8_t>(BackupKind::FULL)) break;
+        entry = find(entry->parentSequence);
+    }
+
+    if (chain.empty() || chain.back().kind != static_cast<uint8_t>(BackupKind::FULL)) {
+        return {};
+    }
+    return std::vector<BackupEntry>(chain.rbegin(), chain.rend());
+}
+
+std::string BackupCatalog::pathForHash(uint64_t contentHash) const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(contentHash));
+    return directory + "/" + name + ".dat";
+}
+
+std::string BackupCatalog::pathFor(const BackupEntry& entry) const {
+    return pathForHash(entry.contentHash);
+}
+
+const char* BackupCatalog::kindName(uint8_t kind) {
+    switch (static_cast<BackupKind>(kind)) {
+        case BackupKind::FULL: return "Full";
+        case BackupKind::INCREMENTAL: return "Incremental";
+        case BackupKind::DIFFERENTIAL: return "Differential";
+        default: return "Unknown";
+    }
+}
+
+bool BackupCatalog::recordRemoval(int id, std::time_t when) {
+    // Nothing to track until a full backup exists
+    if (!latestFull()) return true;
+
+    std::FILE* file = std::fopen(removalsPath().c_str(), "ab");
+    if (!file) return false;
+
+    int32_t storedId = id;
+    int64_t storedTime = static_cast<int64_t>(when);
+    bool ok = std::fwrite(&storedId, sizeof(storedId), 1, file) == 1 &&
+              std::fwrite(&storedTime, sizeof(storedTime), 1, file) == 1;
+    std::fclose(file);
+    return ok;
+}
+
+std::vector<int> BackupCatalog::removalsSince(std::time_t since) const {
+    std::vector<int> ids;
+    std::ifstream file(removalsPath(), std::ios::binary);
+    if (!file.is_open()) return ids;
+
+    int32_t id;
+    int64_t when;
+    while (file.read(reinterpret_cast<char*>(&id), sizeof(id)) &&
+           file.read(reinterpret_cast<char*>(&when), sizeof(when))) {
+        if (when >= static_cast<int64_t>(since)) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+bool BackupCatalog::requireFull() {
+    if (!ensureDirectory()) return false;
+    std::ofstream marker(fullRequiredPath());
+    return marker.is_open();
+}
+
+bool BackupCatalog::fullRequired() const {
+    std::error_code ec;
+    return std::filesystem::exists(fullRequiredPath(), ec);
+}
+
+bool BackupCatalog::startNewChain() {
+    std::error_code ec;
+    std::filesystem::remove(removalsPath(), ec);
+    if (ec) return false;
+    std::filesystem::remove(fullRequiredPath(), ec);
+    return !ec;
+}
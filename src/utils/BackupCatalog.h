@@ -0,0 +1,83 @@
+#ifndef BACKUPCATALOG_H
+#define BACKUPCATALOG_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+enum class BackupKind : uint8_t {
+    FULL = 0,          // Every item
+    INCREMENTAL = 1,   // Changes since the previous backup of any kind
+    DIFFERENTIAL = 2,  // Changes since the last full backup
+    AUTO = 255         // Let FileHandler choose
+};
+
+// One fixed-width catalog record per backup. The backup file itself is
+// named after its content hash: <directory>/<contentHash as hex>.dat
+struct BackupEntry {
+    int64_t timestamp;
+    uint32_t sequence;        // 1-based position in the catalog
+    uint32_t baseSequence;    // Full backup this chain starts from
+    uint32_t parentSequence;  // Backup this one is a delta against (0 for full)
+    uint8_t kind;
+    uint8_t reserved[3];
+    uint64_t itemCount;       // Changed (or all) items stored in the file
+    uint64_t removedCount;    // Tombstoned ids stored after the items
+    uint64_t contentHash;     // FNV-1a 64 of the file
+};
+
+static_assert(sizeof(BackupEntry) == 48, "BackupEntry layout changed");
+
+// Binary catalog (catalog.bin) indexing backups by time, plus an append-only
+// log of removed ids (removals.log) that deltas need for their tombstones.
+// Listing and restoring read only these files - no directory scans.
+class BackupCatalog {
+private:
+    std::string directory;
+    std::vector<BackupEntry> entries;
+    bool loaded;
+
+    bool load();
+    std::string catalogPath() const { return directory + "/catalog.bin"; }
+    std::string removalsPath() const { return directory + "/removals.log"; }
+    std::string fullRequiredPath() const { return directory + "/full.required"; }
+
+public:
+    static const char MAGIC[16];
+    static const int MAX_CHAIN = 8; // Incrementals before a new full backup
+
+    BackupCatalog(const std::string& directory = "backup");
+
+    const std::string& getDirectory() const { return directory; }
+    bool ensureDirectory() const;
+
+    const std::vector<BackupEntry>& list();
+    const BackupEntry* find(uint32_t sequence);
+    const BackupEntry* latest();
+    const BackupEntry* latestFull();
+
+    // Assigns the sequence number and appends the record durably
+    bool append(BackupEntry& entry);
+
+    // Backups to apply in order (full first) to reach the given one
+    std::vector<BackupEntry> chainFor(uint32_t sequence);
+
+    std::string pathFor(const BackupEntry& entry) const;
+    std::string pathForHash(uint64_t contentHash) const;
+    static const char* kindName(uint8_t kind);
+
+    // Removal log
+    bool recordRemoval(int id, std::time_t when);
+    std::vector<int> removalsSince(std::time_t since) const;
+
+    // Force the next backup to be full, e.g. after a bulk import whose
+    // items keep their old updatedAt stamps and would be missed by deltas
+    bool requireFull();
+    bool fullRequired() const;
+
+    // After a full backup: drop the removal log and any full-backup request
+    bool startNewChain();
+};
+
+#endif // BACKUPCATALOG_H
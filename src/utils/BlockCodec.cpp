@@ -0,0 +1,187 @@
+#include "BlockCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+const size_t BlockCodec::MIN_MATCH;
+const size_t BlockCodec::MAX_OFFSET;
+
+namespace {
+
+const int HASH_BITS = 14;
+const size_t LAST_LITERALS = 5; // the tail is always stored as literals
+const uint32_t EMPTY = UINT32_MAX;
+
+inline uint32_t read32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hash4(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void putLength(std::string& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+void emitSequence(std::string& out, const char* literals, size_t literalLength,
+                  size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength - BlockCodec::MIN_MATCH;
+    unsigned char token = static_cast<unsigned char>(
+        (std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15));
+    out.push_back(static_cast<char>(token));
+    if (literalLength >= 15) putLength(out, literalLength - 15);
+    out.append(literals, literalLength);
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (matchCode >= 15) putLength(out, matchCode - 15);
+}
+
+void emitLiterals(std::string& out, const char* literals, size_t literalLength) {
+    out.push_back(static_cast<char>(std::min<size_t>(literalLength, 15) << 4));
+    if (literalLength >= 15) putLength(out, literalLength - 15);
+    out.append(literals, literalLength);
+}
+
+bool readLength(const unsigned char*& in, const unsigned char* end, size_t& length) {
+    unsigned char byte;
+    do {
+        if (in == end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+void BlockCodec::compress(const char* src, size_t size, std::string& out,
+                          std::string_view dictionary) {
+    if (dictionary.size() > MAX_OFFSET) {
+        dictionary = dictionary.substr(dictionary.size() - MAX_OFFSET);
+    }
+
+    // Dictionary and input in one buffer so offsets can reach into the dictionary
+    std::string buffer;
+    buffer.reserve(dictionary.size() + size);
+    buffer.append(dictionary.data(), dictionary.size());
+    buffer.append(src, size);
+    const char* base = buffer.data();
+    size_t start = dictionary.size();
+    size_t end = buffer.size();
+
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, EMPTY);
+    for (size_t p = 0; p + MIN_MATCH <= start; p++) {
+        table[hash4(read32(base + p))] = static_cast<uint32_t>(p);
+    }
+
+    out.reserve(out.size() + maxCompressedSize(size));
+    size_t anchor = start;
+    size_t pos = start;
+    size_t matchLimit = end > start + LAST_LITERALS ? end - LAST_LITERALS : start;
+
+    while (pos + MIN_MATCH <= matchLimit) {
+        uint32_t sequence = read32(base + pos);
+        uint32_t& slot = table[hash4(sequence)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(pos);
+
+        if (candidate == EMPTY || pos - candidate > MAX_OFFSET ||
+            read32(base + candidate) != sequence) {
+            // Step faster through data that keeps missing
+            pos += 1 + ((pos - anchor) >> 6);
+            continue;
+        }
+
+        size_t matchEnd = pos + MIN_MATCH;
+        size_t ref = candidate + MIN_MATCH;
+        while (matchEnd < matchLimit && base[matchEnd] == base[ref]) {
+            matchEnd++;
+            ref++;
+        }
+        while (pos > anchor && candidate > 0 && base[pos - 1] == base[candidate - 1]) {
+            pos--;
+            candidate--;
+        }
+
+        emitSequence(out, base + anchor, pos - anchor, pos - candidate, matchEnd - pos);
+        pos = matchEnd;
+        anchor = pos;
+        table[hash4(read32(base + pos - 2))] = static_cast<uint32_t>(pos - 2);
+    }
+
+    emitLiterals(out, base + anchor, end - anchor);
+}
+
+bool BlockCodec::decompress(const char* src, size_t size, char* dst, size_t rawSize,
+                            std::string_view dictionary) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* end = in + size;
+    size_t out = 0;
+
+    while (in < end) {
+        unsigned token = *in++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(in, end, literals)) return false;
+        if (literals > static_cast<size_t>(end - in) || literals > rawSize - out) return false;
+        std::memcpy(dst + out, in, literals);
+        in += literals;
+        out += literals;
+        if (in == end) break; // literals-only final sequence
+
+        if (end - in < 2) return false;
+        size_t offset = in[0] | (size_t(in[1]) << 8);
+        in += 2;
+        size_t match = token & 15;
+        if (match == 15 && !readLength(in, end, match)) return false;
+        match += MIN_MATCH;
+        if (offset == 0 || offset > out + dictionary.size() || match > rawSize - out) {
+            return false;
+        }
+
+        // Part of the match may lie in the dictionary
+        if (offset > out) {
+            size_t back = offset - out;
+            size_t fromDictionary = std::min(back, match);
+            std::memcpy(dst + out, dictionary.data() + dictionary.size() - back, fromDictionary);
+            out += fromDictionary;
+            match -= fromDictionary;
+        }
+        if (match == 0) continue;
+
+        const char* from = dst + out - offset;
+        if (offset >= match) {
+            std::memcpy(dst + out, from, match);
+        } else {
+            for (size_t i = 0; i < match; i++) { // overlapping run
+                dst[out + i] = from[i];
+            }
+        }
+        out += match;
+    }
+    return out == rawSize;
+}
+
+std::string BlockCodec::buildDictionary(const char* data, size_t size, size_t maxSize) {
+    const size_t SLICE = 256;
+    maxSize = std::min(maxSize, MAX_OFFSET);
+    size_t slices = maxSize / SLICE;
+    if (size <= maxSize || slices == 0) {
+        return std::string(data, std::min(size, maxSize));
+    }
+
+    std::string dictionary;
+    dictionary.reserve(maxSize);
+    size_t stride = size / slices;
+    for (size_t i = 0; i < slices; i++) {
+        dictionary.append(data + i * stride, std::min(SLICE, size - i * stride));
+    }
+    return dictionary;
+}
@@ -0,0 +1,42 @@
+#ifndef BLOCKCODEC_H
+#define BLOCKCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Self-contained LZ77 codec with an LZ4-style sequence format:
+//
+//   [token][literal length+][literals][offset:u16][match length+] ...
+//
+// The token's high nibble is the literal count and the low nibble the match
+// length minus MIN_MATCH; a nibble of 15 continues in 255-valued bytes.
+// The last sequence carries literals only.
+//
+// An optional dictionary acts as history in front of every block, so short
+// independent blocks can still reference common text.
+class BlockCodec {
+public:
+    static const size_t MIN_MATCH = 4;
+    static const size_t MAX_OFFSET = 65535;
+
+    // Worst case output size for incompressible input
+    static size_t maxCompressedSize(size_t rawSize) {
+        return rawSize + rawSize / 255 + 16;
+    }
+
+    // Append the compressed form of src to out
+    static void compress(const char* src, size_t size, std::string& out,
+                         std::string_view dictionary = std::string_view());
+
+    // Decode exactly rawSize bytes into dst; false on malformed input
+    static bool decompress(const char* src, size_t size, char* dst, size_t rawSize,
+                           std::string_view dictionary = std::string_view());
+
+    // Sample evenly spaced slices of data into a dictionary of at most
+    // maxSize bytes (the codec can reach back MAX_OFFSET bytes in total)
+    static std::string buildDictionary(const char* data, size_t size, size_t maxSize);
+};
+
+#endif // BLOCKCODEC_H
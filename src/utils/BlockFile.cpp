@@ -0,0 +1,220 @@
+#include "BlockFile.h"
+#include "BlockCodec.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+const char BlockFile::MAGIC[16] = "TODO_BLOCK_V1";
+
+BlockFile::BlockFile() : header{} {}
+
+// FNV-1a, catches a damaged block before it is decoded
+uint32_t BlockFile::checksum(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool BlockFile::isBlockFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool BlockFile::write(const std::string& path, const char* data, size_t size,
+                      uint32_t blockSize, bool useDictionary) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open file " << path << " for writing" << std::endl;
+        return false;
+    }
+    if (blockSize == 0) blockSize = DEFAULT_BLOCK_SIZE;
+    if (blockSize > MAX_BLOCK_SIZE) blockSize = MAX_BLOCK_SIZE;
+
+    // A single block has nothing to share a dictionary with
+    std::string dictionary;
+    if (useDictionary && size > blockSize) {
+        dictionary = BlockCodec::buildDictionary(data, size, DICTIONARY_SIZE);
+    }
+
+    BlockFileHeader head{};
+    std::memcpy(head.magic, MAGIC, sizeof(head.magic));
+    head.version = VERSION;
+    head.blockSize = blockSize;
+    head.rawSize = size;
+    head.blockCount = (size + blockSize - 1) / blockSize;
+    head.dictionaryOffset = sizeof(BlockFileHeader);
+    head.dictionarySize = static_cast<uint32_t>(dictionary.size());
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(dictionary.data(), dictionary.size());
+
+    std::vector<BlockIndexEntry> entries;
+    entries.reserve(head.blockCount);
+    uint64_t offset = head.dictionaryOffset + dictionary.size();
+    std::string compressed;
+
+    for (size_t start = 0; start < size; start += blockSize) {
+        size_t length = std::min<size_t>(blockSize, size - start);
+        compressed.clear();
+        BlockCodec::compress(data + start, length, compressed, dictionary);
+
+        BlockIndexEntry entry{};
+        entry.offset = offset;
+        entry.rawSize = static_cast<uint32_t>(length);
+        if (compressed.size() >= length) {
+            compressed.assign(data + start, length);
+            entry.flags = STORED;
+        }
+        entry.compressedSize = static_cast<uint32_t>(compressed.size());
+        entry.checksum = checksum(compressed.data(), compressed.size());
+        out.write(compressed.data(), compressed.size());
+
+        offset += compressed.size();
+        entries.push_back(entry);
+    }
+
+    head.indexOffset = offset;
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BlockIndexEntry));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+    out.close();
+    return !out.fail();
+}
+
+bool BlockFile::compressFile(const std::string& path, uint32_t blockSize, bool useDictionary) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+    std::string raw(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    if (!in.read(&raw[0], raw.size())) return false;
+    in.close();
+
+    std::string compressedPath = path + ".z";
+    if (!write(compressedPath, raw.data(), raw.size(), blockSize, useDictionary)) {
+        std::remove(compressedPath.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(compressedPath, path, ec);
+    return !ec;
+}
+
+bool BlockFile::open(const std::string& path) {
+    close();
+
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    // Sizes are checked against what is left of the file, never by adding
+    // two untrusted fields that could wrap around
+    std::error_code ec;
+    uint64_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.blockSize == 0 || header.blockSize > MAX_BLOCK_SIZE ||
+        header.dictionarySize > BlockCodec::MAX_OFFSET ||
+        header.dictionaryOffset > fileSize ||
+        header.dictionarySize > fileSize - header.dictionaryOffset ||
+        header.indexOffset > fileSize ||
+        header.blockCount != header.rawSize / header.blockSize + (header.rawSize % header.blockSize != 0) ||
+        header.blockCount > (fileSize - header.indexOffset) / sizeof(BlockIndexEntry)) {
+        close();
+        return false;
+    }
+
+    dictionary.resize(header.dictionarySize);
+    index.resize(header.blockCount);
+    file.seekg(header.dictionaryOffset);
+    file.read(&dictionary[0], dictionary.size());
+    file.seekg(header.indexOffset);
+    file.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(BlockIndexEntry));
+    if (!file) {
+        close();
+        return false;
+    }
+
+    // Blocks must tile the raw data and lie between the dictionary and the index
+    uint64_t dataStart = header.dictionaryOffset + header.dictionarySize;
+    if (header.indexOffset < dataStart) {
+        close();
+        return false;
+    }
+    uint64_t raw = 0;
+    for (const auto& entry : index) {
+        if (entry.offset < dataStart || entry.offset > header.indexOffset ||
+            entry.compressedSize > header.indexOffset - entry.offset ||
+            entry.rawSize > header.blockSize || (entry.flags == STORED && entry.compressedSize != entry.rawSize)) {
+            close();
+            return false;
+        }
+        raw += entry.rawSize;
+    }
+    if (raw != header.rawSize) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void BlockFile::close() {
+    if (file.is_open()) file.close();
+    file.clear();
+    header = BlockFileHeader{};
+    dictionary.clear();
+    index.clear();
+}
+
+bool BlockFile::decodeBlock(const BlockIndexEntry& entry, const char* compressed, char* dst) const {
+    if (checksum(compressed, entry.compressedSize) != entry.checksum) {
+        return false;
+    }
+    if (entry.flags == STORED) {
+        std::memcpy(dst, compressed, entry.rawSize);
+        return true;
+    }
+    return BlockCodec::decompress(compressed, entry.compressedSize, dst, entry.rawSize, dictionary);
+}
+
+bool BlockFile::readBlock(size_t block, std::string& out) {
+    if (block >= index.size()) return false;
+
+    const BlockIndexEntry& entry = index[block];
+    std::string compressed(entry.compressedSize, '\0');
+    file.seekg(entry.offset);
+    if (!file.read(&compressed[0], compressed.size())) {
+        file.clear();
+        return false;
+    }
+
+    out.resize(entry.rawSize);
+    return decodeBlock(entry, compressed.data(), &out[0]);
+}
+
+bool BlockFile::readAll(char* dst) {
+    if (!isOpen()) return false;
+
+    // One read for the whole block region, then decode block by block
+    uint64_t dataStart = header.dictionaryOffset + header.dictionarySize;
+    std::vector<char> compressed(header.indexOffset - dataStart);
+    file.seekg(dataStart);
+    if (!file.read(compressed.data(), compressed.size())) {
+        file.clear();
+        return false;
+    }
+
+    uint64_t out = 0;
+    for (const auto& entry : index) {
+        if (!decodeBlock(entry, compressed.data() + (entry.offset - dataStart), dst + out)) {
+            return false;
+        }
+        out += entry.rawSize;
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef BLOCKFILE_H
+#define BLOCKFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Block-compressed container (TODO_BLOCK_V1) around any file:
+//
+//   [BlockFileHeader][dictionary][block 0][block 1]...[BlockIndexEntry x blockCount]
+//
+// Every block is compressed independently with BlockCodec against the shared
+// dictionary, so any block can be decoded on its own through the index.
+struct BlockFileHeader {
+    char magic[16];          // "TODO_BLOCK_V1", zero padded
+    uint32_t version;
+    uint32_t blockSize;      // Raw bytes per block (the last may be shorter)
+    uint64_t rawSize;
+    uint64_t blockCount;
+    uint64_t dictionaryOffset;
+    uint32_t dictionarySize;
+    uint32_t reserved;
+    uint64_t indexOffset;
+};
+
+struct BlockIndexEntry {
+    uint64_t offset;         // Position of the compressed block in the file
+    uint32_t compressedSize;
+    uint32_t rawSize;
+    uint32_t checksum;       // FNV-1a of the compressed bytes
+    uint32_t flags;          // STORED: block kept raw because it did not shrink
+};
+
+static_assert(sizeof(BlockFileHeader) == 64, "BlockFileHeader layout changed");
+static_assert(sizeof(BlockIndexEntry) == 24, "BlockIndexEntry layout changed");
+
+class BlockFile {
+private:
+    std::ifstream file;
+    BlockFileHeader header;
+    std::string dictionary;
+    std::vector<BlockIndexEntry> index;
+
+    bool decodeBlock(const BlockIndexEntry& entry, const char* compressed, char* dst) const;
+    static uint32_t checksum(const char* data, size_t length);
+
+public:
+    static const char MAGIC[16];
+    static const uint32_t VERSION = 1;
+    static const uint32_t STORED = 1;
+    static const uint32_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static const uint32_t MAX_BLOCK_SIZE = 16 * 1024 * 1024; // bounds one block's buffer
+    static const uint32_t DICTIONARY_SIZE = 32 * 1024;
+
+    BlockFile();
+
+    // True if the file at path starts with the block container magic
+    static bool isBlockFile(const std::string& path);
+
+    // Compress data into a new container at path
+    static bool write(const std::string& path, const char* data, size_t size,
+                      uint32_t blockSize = DEFAULT_BLOCK_SIZE, bool useDictionary = true);
+
+    // Replace an uncompressed file with its compressed container
+    static bool compressFile(const std::string& path, uint32_t blockSize = DEFAULT_BLOCK_SIZE,
+                             bool useDictionary = true);
+
+    // Reading: open() loads only the header, dictionary and block index
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    uint64_t rawSize() const { return header.rawSize; }
+    uint32_t blockSize() const { return header.blockSize; }
+    size_t blockCount() const { return index.size(); }
+
+    // Random access: decode one block into out
+    bool readBlock(size_t block, std::string& out);
+
+    // Decode everything into dst, which must hold rawSize() bytes
+    bool readAll(char* dst);
+};
+
+#endif // BLOCKFILE_H
@@ -0,0 +1,54 @@
+#include "BufferedFile.h"
+#include <cstring>
+
+BufferedFile::BufferedFile() : file(nullptr), used(0), failed(false) {}
+
+BufferedFile::~BufferedFile() {
+    close();
+}
+
+bool BufferedFile::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    buffer.resize(BUFFER_SIZE);
+    used = 0;
+    failed = false;
+    return true;
+}
+
+bool BufferedFile::close() {
+    if (!file) return !failed;
+
+    flush();
+    if (std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+void BufferedFile::flush() {
+    if (used > 0 && file && std::fwrite(buffer.data(), 1, used, file) != used) {
+        failed = true;
+    }
+    used = 0;
+}
+
+char* BufferedFile::reserve(size_t bytes) {
+    if (buffer.size() - used < bytes) {
+        flush();
+        if (buffer.size() < bytes) buffer.resize(bytes);
+    }
+    return buffer.data() + used;
+}
+
+void BufferedFile::append(const char* data, size_t length) {
+    if (length > buffer.size()) {
+        // Too big to stage: write it straight through
+        flush();
+        if (file && std::fwrite(data, 1, length, file) != length) failed = true;
+        return;
+    }
+    std::memcpy(reserve(length), data, length);
+    used += length;
+}
@@ -0,0 +1,45 @@
+#ifndef BUFFEREDFILE_H
+#define BUFFEREDFILE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Output file behind one reusable block, written in large fwrite calls.
+// Shared by the CSV and JSON writers: they format straight into the block
+// through reserve() / commit(), and any failed write sticks until open().
+class BufferedFile {
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    bool failed;
+
+public:
+    static const size_t BUFFER_SIZE = 1024 * 1024;
+
+    BufferedFile();
+    ~BufferedFile();
+
+    BufferedFile(const BufferedFile&) = delete;
+    BufferedFile& operator=(const BufferedFile&) = delete;
+
+    bool open(const std::string& path);
+    bool close(); // flushes; false if any write failed
+    void flush();
+
+    // Room for bytes more, flushing first if the block is too full; grows
+    // the block only for a single oversized value. Returns where they go
+    char* reserve(size_t bytes);
+    // Mark everything up to end (inside the reserved room) as written
+    void commit(char* end) { used = end - buffer.data(); }
+
+    // Copies data; anything larger than the block is written straight through
+    void append(const char* data, size_t length);
+    void put(char c) { *reserve(1) = c; used++; }
+
+    bool good() const { return !failed; }
+};
+
+#endif // BUFFEREDFILE_H
@@ -0,0 +1,59 @@
+#include "CsvWriter.h"
+#include <charconv>
+
+namespace {
+
+// True if the field has to be quoted
+bool needsQuoting(std::string_view text) {
+    for (char c : text) {
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') return true;
+    }
+    return false;
+}
+
+} // namespace
+
+CsvWriter::CsvWriter() : rowStarted(false) {}
+
+bool CsvWriter::open(const std::string& path) {
+    rowStarted = false;
+    return out.open(path);
+}
+
+void CsvWriter::separator() {
+    if (rowStarted) out.put(',');
+    rowStarted = true;
+}
+
+void CsvWriter::field(std::string_view text) {
+    separator();
+
+    if (!needsQuoting(text)) {
+        out.append(text.data(), text.size());
+        return;
+    }
+
+    // Worst case every character is a quote
+    char* dst = out.reserve(text.size() * 2 + 2);
+    *dst++ = '"';
+    for (char c : text) {
+        if (c == '"') *dst++ = '"';
+        *dst++ = c;
+    }
+    *dst++ = '"';
+    out.commit(dst);
+}
+
+void CsvWriter::field(int64_t value) {
+    separator();
+    char* dst = out.reserve(24);
+    out.commit(std::to_chars(dst, dst + 24, value).ptr);
+}
+
+void CsvWriter::endRow() {
+    char* dst = out.reserve(2);
+    *dst++ = '\r';
+    *dst++ = '\n';
+    out.commit(dst);
+    rowStarted = false;
+}
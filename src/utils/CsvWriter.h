@@ -0,0 +1,37 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include "BufferedFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Streaming RFC 4180 writer. Rows are formatted straight into one reusable
+// buffer (numbers via std::to_chars) and flushed in large writes, so
+// exporting costs no per-field stream calls and no per-row allocations.
+//
+// Fields containing a comma, quote, CR or LF are quoted and embedded
+// quotes are doubled; rows end in CRLF as the RFC specifies.
+class CsvWriter {
+private:
+    BufferedFile out;
+    bool rowStarted;
+
+    void separator();
+
+public:
+    static const size_t BUFFER_SIZE = BufferedFile::BUFFER_SIZE;
+
+    CsvWriter();
+
+    bool open(const std::string& path);
+    bool close() { return out.close(); } // flushes; false if any write failed
+
+    void field(std::string_view text);
+    void field(int64_t value);
+    void endRow();
+
+    bool good() const { return out.good(); }
+};
+
+#endif // CSVWRITER_H
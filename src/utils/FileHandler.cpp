@@ -1,48 +1,67 @@
 #include "FileHandler.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
 #include <cstring>
+#include <filesystem>
 #include <sys/stat.h>
+#include <unordered_map>
 #include <vector>
 
-FileHandler::FileHandler(const std::string& filename) : filename(filename) {}
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
+FileHandler::FileHandler(const std::string& filename)
+    : filename(filename), compressionBlockSize(0) {}
+
+void FileHandler::setCompression(bool enabled, uint32_t blockSize) {
+    compressionBlockSize = enabled ? blockSize : 0;
+}
+
+// Block-compress a freshly written store before it is renamed into place
+bool FileHandler::compressIfEnabled(const std::string& path) {
+    if (compressionBlockSize == 0) return true;
+    return BlockFile::compressFile(path, compressionBlockSize);
+}
+
+// Items are streamed straight from the heap array in heap order; the
+// loader re-heapifies in O(n), so no sorted copy is needed here.
 bool FileHandler::saveToFile(const PriorityQueue& todos) {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << " for writing" << std::endl;
+    return commitStore(todos.items());
+}
+
+bool FileHandler::saveToFile(const std::vector<TodoItem>& todos) {
+    return commitStore(todos);
+}
+
+// Live items in display order, straight out of the slot chunks
+bool FileHandler::saveToFile(const SlotMap& todos) {
+    return commitStore(todos);
+}
+
+template <typename Items>
+bool FileHandler::commitStore(const Items& todos) {
+    // Write a side file and swap it in, so a crash never leaves a torn store.
+    std::string tempFilename = filename + ".tmp";
+    if (!writeStore(tempFilename, todos) ||
+        !compressIfEnabled(tempFilename) ||
+        !replaceFile(tempFilename, filename)) {
+        std::cerr << "Error: Could not commit " << filename << std::endl;
+        std::remove(tempFilename.c_str());
         return false;
     }
     
-    // Write header with version and timestamp
-    std::time_t now = std::time(nullptr);
-    file << "TODO_DATA_V1.0|" << now << "\n";
-    
-    // Convert priority queue to vector for saving
-    std::vector<TodoItem> itemsToSave;
-    PriorityQueue tempQueue = todos; // Create copy
-    
-    while (!tempQueue.isEmpty()) {
-        itemsToSave.push_back(tempQueue.pop());
-    }
-    
-    // Save count
-    size_t count = itemsToSave.size();
-    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
-    
-    // Save each todo
-    for (const auto& item : itemsToSave) {
-        std::string serialized = serializeTodo(item);
-        size_t length = serialized.length();
-        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
-        file.write(serialized.c_str(), length);
-    }
-    
-    file.close();
-    std::cout << "✅ Saved " << count << " todos to " << filename << std::endl;
+    std::cout << "✅ Saved " << todos.size() << " todos to " << filename << std::endl;
     return true;
 }
 
@@ -53,7 +72,28 @@ bool FileHandler::loadFromFile(PriorityQueue& todos) {
         return false;
     }
     
-    // Read header
+    if (MappedStore::isV2File(filename)) {
+        file.close();
+        
+        MappedStore store;
+        if (!store.open(filename)) {
+            std::cout << "⚠️  Invalid file format." << std::endl;
+            return false;
+        }
+        
+        std::cout << "📥 Loading " << store.size() << " todos from " << filename << "..." << std::endl;
+        std::vector<TodoItem> items;
+        items.reserve(store.size());
+        for (size_t i = 0; i < store.size(); i++) {
+            items.push_back(store.materialize(i));
+        }
+        todos.pushAll(std::move(items));
+        
+        std::cout << "✅ Loaded " << store.size() << " todos successfully." << std::endl;
+        return true;
+    }
+    
+    // Legacy TODO_DATA_V1.0 files: pipe-delimited text records
     std::string header;
     std::getline(file, header);
     
@@ -68,6 +108,8 @@ bool FileHandler::loadFromFile(PriorityQueue& todos) {
     
     std::cout << "📥 Loading " << count << " todos from " << filename << "..." << std::endl;
     
+    std::vector<TodoItem> items;
+    items.reserve(count);
     for (size_t i = 0; i < count; i++) {
         // Read length
         size_t length;
@@ -81,83 +123,302 @@ bool FileHandler::loadFromFile(PriorityQueue& todos) {
         std::string serialized(buffer);
         delete[] buffer;
         
-        // Deserialize and add to queue
-        TodoItem item = deserializeTodo(serialized);
-        todos.push(item);
+        items.push_back(deserializeTodo(serialized));
     }
+    todos.pushAll(std::move(items));
     
     file.close();
     std::cout << "✅ Loaded " << count << " todos successfully." << std::endl;
     return true;
 }
 
-bool FileHandler::createBackup(const std::vector<TodoItem>& todos) {
-    try {
-        std::string timestamp = getCurrentTimestamp();
-        std::string backupFilename = "backup/todo_backup_" + timestamp + ".dat";
-        
-        // Create backup directory if it doesn't exist
-        #ifdef _WIN32
-        system("mkdir backup 2>nul");
-        #else
-        system("mkdir -p backup 2>/dev/null");
-        #endif
-        
-        std::ofstream backupFile(backupFilename, std::ios::binary);
-        if (!backupFile.is_open()) {
-            std::cerr << "❌ Could not create backup file: " << backupFilename << std::endl;
-            return false;
-        }
-        
-        // Write backup header
-        backupFile << "TODO_BACKUP_V1.0|" << std::time(nullptr) << "\n";
+// Two streaming passes: fixed-width records first (string offsets are a
+// running sum), then the string heap, then the id-sorted footer index.
+template <typename Items>
+bool FileHandler::writeStore(const std::string& path, const Items& todos) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << path << " for writing" << std::endl;
+        return false;
+    }
+    
+    size_t count = todos.size();
+    uint64_t heapSize = 0;
+    for (const TodoItem& item : todos) {
+        heapSize += item.title.size() + item.description.size() + item.dueDate.size();
+    }
+    if (heapSize > UINT32_MAX) {
+        std::cerr << "Error: String data exceeds the 4 GB limit of the V2 format" << std::endl;
+        return false;
+    }
+    
+    StoreHeader header{};
+    std::memcpy(header.magic, MappedStore::MAGIC, sizeof(header.magic));
+    header.version = MappedStore::VERSION;
+    header.recordSize = sizeof(StoreRecord);
+    header.count = count;
+    header.recordsOffset = sizeof(StoreHeader);
+    header.heapOffset = header.recordsOffset + count * sizeof(StoreRecord);
+    header.heapSize = heapSize;
+    header.indexOffset = (header.heapOffset + heapSize + 7) & ~uint64_t(7);
+    header.savedAt = static_cast<int64_t>(std::time(nullptr));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    std::vector<StoreIndexEntry> index(count);
+    uint32_t offset = 0;
+    size_t i = 0;
+    for (const TodoItem& item : todos) {
+        StoreRecord record{};
+        record.id = item.id;
+        record.priority = static_cast<uint8_t>(item.priority);
+        record.status = static_cast<uint8_t>(item.status);
+        record.createdAt = static_cast<int64_t>(item.createdAt);
+        record.updatedAt = static_cast<int64_t>(item.updatedAt);
+        record.titleOffset = offset;
+        record.titleLength = static_cast<uint32_t>(item.title.size());
+        offset += record.titleLength;
+        record.descriptionOffset = offset;
+        record.descriptionLength = static_cast<uint32_t>(item.description.size());
+        offset += record.descriptionLength;
+        record.dueDateOffset = offset;
+        record.dueDateLength = static_cast<uint32_t>(item.dueDate.size());
+        offset += record.dueDateLength;
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
         
-        // Save count
-        size_t count = todos.size();
-        backupFile.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        index[i] = {item.id, static_cast<uint32_t>(i)};
+        i++;
+    }
+    
+    for (const TodoItem& item : todos) {
+        file.write(item.title.data(), item.title.size());
+        file.write(item.description.data(), item.description.size());
+        file.write(item.dueDate.data(), item.dueDate.size());
+    }
+    
+    const char padding[8] = {};
+    file.write(padding, header.indexOffset - (header.heapOffset + heapSize));
+    
+    std::sort(index.begin(), index.end(),
+              [](const StoreIndexEntry& a, const StoreIndexEntry& b) {
+                  return a.id < b.id;
+              });
+    file.write(reinterpret_cast<const char*>(index.data()), count * sizeof(StoreIndexEntry));
+    
+    file.close();
+    return !file.fail();
+}
+
+bool FileHandler::createBackup(const std::vector<TodoItem>& todos, BackupKind kind) {
+    return writeBackup(todos, kind);
+}
+
+bool FileHandler::createBackup(const SlotMap& todos, BackupKind kind) {
+    return writeBackup(todos, kind);
+}
+
+// Full backups store every item. Deltas store only items whose updatedAt
+// is at or after the parent backup, plus ids removed since then, so the
+// cost follows the churn rather than the size of the store.
+template <typename Items>
+bool FileHandler::writeBackup(const Items& todos, BackupKind kind) {
+    if (!catalog.ensureDirectory()) {
+        std::cerr << "❌ Could not create backup directory: " << catalog.getDirectory() << std::endl;
+        return false;
+    }
+    
+    const BackupEntry* last = catalog.latest();
+    const BackupEntry* base = catalog.latestFull();
+    
+    if (kind == BackupKind::AUTO) {
+        bool chainTooLong = base && last->sequence - base->sequence >= BackupCatalog::MAX_CHAIN;
+        kind = (!base || chainTooLong) ? BackupKind::FULL : BackupKind::INCREMENTAL;
+    }
+    if (!base || catalog.fullRequired()) {
+        kind = BackupKind::FULL;
+    }
+    
+    BackupEntry entry{};
+    entry.timestamp = static_cast<int64_t>(std::time(nullptr));
+    entry.kind = static_cast<uint8_t>(kind);
+    
+    size_t count = todos.size();
+    std::vector<TodoItem> changed;
+    std::vector<int> removed;
+    
+    if (kind != BackupKind::FULL) {
+        const BackupEntry& parent = (kind == BackupKind::INCREMENTAL) ? *last : *base;
+        entry.parentSequence = parent.sequence;
+        entry.baseSequence = base->sequence;
         
-        // Save each todo
         for (const auto& item : todos) {
-            std::string serialized = serializeTodo(item);
-            size_t length = serialized.length();
-            backupFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
-            backupFile.write(serialized.c_str(), length);
+            if (item.updatedAt >= parent.timestamp) {
+                changed.push_back(item);
+            }
         }
-        
-        backupFile.close();
-        
-        // Also create a CSV backup
-        exportToCSV(todos);
-        
-        std::cout << "✅ Backup created: " << backupFilename << std::endl;
-        std::cout << "📊 Backed up " << count << " todos" << std::endl;
-        return true;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "❌ Backup failed: " << e.what() << std::endl;
+        removed = catalog.removalsSince(static_cast<std::time_t>(parent.timestamp));
+        count = changed.size();
+    }
+    
+    // Items as a V2 store, removed ids appended after its footer index
+    std::string tempFilename = catalog.getDirectory() + "/backup.tmp";
+    bool written = (kind == BackupKind::FULL) ? writeStore(tempFilename, todos)
+                                              : writeStore(tempFilename, changed);
+    if (!written) {
+        std::cerr << "❌ Backup failed: could not write " << tempFilename << std::endl;
+        return false;
+    }
+    if (!removed.empty()) {
+        std::ofstream tail(tempFilename, std::ios::binary | std::ios::app);
+        for (int id : removed) {
+            int32_t storedId = id;
+            tail.write(reinterpret_cast<const char*>(&storedId), sizeof(storedId));
+        }
+        if (!tail) {
+            std::cerr << "❌ Backup failed: could not write removals" << std::endl;
+            return false;
+        }
+    }
+    if (!compressIfEnabled(tempFilename)) {
+        std::cerr << "❌ Backup failed: could not compress " << tempFilename << std::endl;
+        return false;
+    }
+    
+    // Content addressed: the file is named after its hash
+    uint64_t contentHash;
+    if (!hashFile(tempFilename, contentHash)) {
+        std::cerr << "❌ Backup failed: could not read back " << tempFilename << std::endl;
         return false;
     }
+    
+    std::string backupFilename = catalog.pathForHash(contentHash);
+    if (std::filesystem::exists(backupFilename)) {
+        std::remove(tempFilename.c_str()); // identical content already stored
+    } else if (!replaceFile(tempFilename, backupFilename)) {
+        std::cerr << "❌ Could not create backup file: " << backupFilename << std::endl;
+        return false;
+    }
+    
+    entry.itemCount = count;
+    entry.removedCount = removed.size();
+    entry.contentHash = contentHash;
+    if (!catalog.append(entry)) {
+        std::cerr << "❌ Could not update backup catalog" << std::endl;
+        return false;
+    }
+    if (kind == BackupKind::FULL) {
+        catalog.startNewChain();
+    }
+    
+    std::cout << "✅ Backup #" << entry.sequence << " (" << BackupCatalog::kindName(entry.kind)
+              << ") created: " << backupFilename << std::endl;
+    std::cout << "📊 Backed up " << count << " todos";
+    if (!removed.empty()) {
+        std::cout << " and " << removed.size() << " removals";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+bool FileHandler::recordRemoval(int id) {
+    return catalog.recordRemoval(id, std::time(nullptr));
+}
+
+bool FileHandler::requireFullBackup() {
+    return catalog.requireFull();
 }
 
 bool FileHandler::restoreFromBackup() {
-    // List available backups
+    // List available backups from the catalog
+    const auto& entries = catalog.list();
     std::cout << "Available backups:" << std::endl;
+    if (entries.empty()) {
+        std::cout << "  (catalog is empty)" << std::endl;
+    }
+    for (const auto& entry : entries) {
+        std::time_t when = static_cast<std::time_t>(entry.timestamp);
+        char buffer[20];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&when));
+        std::cout << "  [" << entry.sequence << "] " << buffer << "  "
+                  << std::left << std::setw(13) << BackupCatalog::kindName(entry.kind) << std::right
+                  << entry.itemCount << " todos, " << entry.removedCount << " removals" << std::endl;
+    }
     
-    #ifdef _WIN32
-    system("dir backup\\*.dat /b 2>nul");
-    #else
-    system("ls backup/*.dat 2>/dev/null");
-    #endif
-    
-    std::string backupFile;
-    std::cout << "\nEnter backup filename (or press Enter to cancel): ";
-    std::getline(std::cin, backupFile);
+    std::string choice;
+    std::cout << "\nEnter backup number, or a legacy backup filename (or press Enter to cancel): ";
+    std::getline(std::cin, choice);
     
-    if (backupFile.empty()) {
+    if (choice.empty()) {
         std::cout << "Restore cancelled." << std::endl;
         return false;
     }
     
+    if (choice.find_first_not_of("0123456789") == std::string::npos) {
+        uint64_t sequence;
+        const char* end = choice.data() + choice.size();
+        auto parsed = std::from_chars(choice.data(), end, sequence);
+        if (parsed.ec != std::errc() || parsed.ptr != end || sequence > UINT32_MAX) {
+            std::cerr << "❌ Backup #" << choice << " not found in catalog" << std::endl;
+            return false;
+        }
+        return restoreFromCatalog(static_cast<uint32_t>(sequence));
+    }
+    return restoreLegacyBackup(choice);
+}
+
+bool FileHandler::restoreFromCatalog(uint32_t sequence) {
+    std::vector<BackupEntry> chain = catalog.chainFor(sequence);
+    if (chain.empty()) {
+        std::cerr << "❌ Backup #" << sequence << " not found in catalog" << std::endl;
+        return false;
+    }
+    
+    // Apply the full backup, then each delta in order
+    std::unordered_map<int, TodoItem> restored;
+    for (const auto& entry : chain) {
+        std::string path = catalog.pathFor(entry);
+        uint64_t contentHash;
+        MappedStore store;
+        if (!hashFile(path, contentHash) || contentHash != entry.contentHash || !store.open(path)) {
+            std::cerr << "❌ Backup file missing or corrupt: " << path << std::endl;
+            return false;
+        }
+        
+        std::string_view tail = store.trailer();
+        for (size_t i = 0; i + sizeof(int32_t) <= tail.size() && i / sizeof(int32_t) < entry.removedCount;
+             i += sizeof(int32_t)) {
+            int32_t id;
+            std::memcpy(&id, tail.data() + i, sizeof(id));
+            restored.erase(id);
+        }
+        for (size_t i = 0; i < store.size(); i++) {
+            TodoItem item = store.materialize(i);
+            restored[item.id] = std::move(item);
+        }
+    }
+    
+    std::vector<TodoItem> items;
+    items.reserve(restored.size());
+    for (auto& pair : restored) {
+        items.push_back(std::move(pair.second));
+    }
+    std::sort(items.begin(), items.end(),
+              [](const TodoItem& a, const TodoItem& b) { return a.id < b.id; });
+    
+    std::cout << "📥 Restoring " << items.size() << " todos from backup #" << sequence
+              << " (" << chain.size() << " file(s))..." << std::endl;
+    
+    if (!saveToFile(items)) {
+        return false;
+    }
+    
+    // Later deltas must build on the restored state, not the old chain
+    createBackup(items, BackupKind::FULL);
+    std::cout << "✅ Restore completed successfully!" << std::endl;
+    return true;
+}
+
+// Pre-catalog backups: TODO_BACKUP_V1.0 text records
+bool FileHandler::restoreLegacyBackup(std::string backupFile) {
     // Add backup/ prefix if not present
     if (backupFile.find("backup/") == std::string::npos && 
         backupFile.find("backup\\") == std::string::npos) {
@@ -193,8 +454,8 @@ bool FileHandler::restoreFromBackup() {
     
     std::cout << "📥 Restoring " << count << " todos..." << std::endl;
     
-    // Create priority queue to return
-    PriorityQueue restoredQueue;
+    std::vector<TodoItem> restored;
+    restored.reserve(count);
     
     for (size_t i = 0; i < count; i++) {
         // Read length
@@ -209,103 +470,160 @@ bool FileHandler::restoreFromBackup() {
         std::string serialized(buffer);
         delete[] buffer;
         
-        // Deserialize and add to queue
-        TodoItem item = deserializeTodo(serialized);
-        restoredQueue.push(item);
+        restored.push_back(deserializeTodo(serialized));
     }
     
     file.close();
     
     // Save restored data to main file
-    if (saveToFile(restoredQueue)) {
-        std::cout << "✅ Restore completed successfully!" << std::endl;
-        return true;
+    if (!saveToFile(restored)) {
+        return false;
     }
     
-    return false;
+    // As for a catalog restore: later deltas must build on the restored
+    // state, not the old chain
+    createBackup(restored, BackupKind::FULL);
+    std::cout << "✅ Restore completed successfully!" << std::endl;
+    return true;
 }
 
 bool FileHandler::exportToCSV(const std::vector<TodoItem>& todos) {
+    return writeCSV(todos);
+}
+
+bool FileHandler::exportToCSV(const SlotMap& todos) {
+    return writeCSV(todos);
+}
+
+template <typename Items>
+bool FileHandler::writeCSV(const Items& todos) {
     std::string timestamp = getCurrentTimestamp();
     std::string csvFilename = "exports/todos_export_" + timestamp + ".csv";
     
-    // Create exports directory if it doesn't exist
-    #ifdef _WIN32
-    system("mkdir exports 2>nul");
-    #else
-    system("mkdir -p exports 2>/dev/null");
-    #endif
+    std::error_code ec;
+    std::filesystem::create_directories("exports", ec);
     
-    std::ofstream csvFile(csvFilename);
-    if (!csvFile.is_open()) {
+    CsvWriter csv;
+    if (!csv.open(csvFilename)) {
         std::cerr << "❌ Could not create CSV file: " << csvFilename << std::endl;
         return false;
     }
     
     // Write CSV header
-    csvFile << "ID,Title,Description,Due Date,Priority,Status,Created At,Updated At\n";
+    for (const char* column : {"ID", "Title", "Description", "Due Date",
+                               "Priority", "Status", "Created At", "Updated At"}) {
+        csv.field(column);
+    }
+    csv.endRow();
     
     // Write each todo
     for (const auto& item : todos) {
-        csvFile << item.id << ","
-                << "\"" << item.title << "\","
-                << "\"" << item.description << "\","
-                << item.dueDate << ","
-                << item.priorityToString() << ","
-                << item.statusToString() << ","
-                << item.createdAt << ","
-                << item.updatedAt << "\n";
+        csv.field(static_cast<int64_t>(item.id));
+        csv.field(item.title);
+        csv.field(item.description);
+        csv.field(item.dueDate);
+        csv.field(TodoItem::priorityName(item.priority));
+        csv.field(TodoItem::statusName(item.status));
+        csv.field(static_cast<int64_t>(item.createdAt));
+        csv.field(static_cast<int64_t>(item.updatedAt));
+        csv.endRow();
     }
     
-    csvFile.close();
+    if (!csv.close()) {
+        std::cerr << "❌ Could not write CSV file: " << csvFilename << std::endl;
+        return false;
+    }
     std::cout << "✅ CSV exported: " << csvFilename << std::endl;
     return true;
 }
 
 bool FileHandler::exportToJSON(const std::vector<TodoItem>& todos) {
+    return writeJSON(todos, false);
+}
+
+bool FileHandler::exportToNDJSON(const std::vector<TodoItem>& todos) {
+    return writeJSON(todos, true);
+}
+
+bool FileHandler::exportToJSON(const SlotMap& todos) {
+    return writeJSON(todos, false);
+}
+
+bool FileHandler::exportToNDJSON(const SlotMap& todos) {
+    return writeJSON(todos, true);
+}
+
+namespace {
+
+// One todo object, either indented for .json or on one line for NDJSON
+template <typename Item>
+void writeJSONItem(JsonWriter& json, const Item& item, bool pretty) {
+    static const char* const prettyKeys[] = {
+        "    {\n      \"id\": ", ",\n      \"title\": ", ",\n      \"description\": ",
+        ",\n      \"dueDate\": ", ",\n      \"priority\": ", ",\n      \"status\": ",
+        ",\n      \"createdAt\": ", ",\n      \"updatedAt\": ", "\n    }"
+    };
+    static const char* const compactKeys[] = {
+        "{\"id\":", ",\"title\":", ",\"description\":", ",\"dueDate\":",
+        ",\"priority\":", ",\"status\":", ",\"createdAt\":", ",\"updatedAt\":", "}"
+    };
+    const char* const* keys = pretty ? prettyKeys : compactKeys;
+    
+    json.raw(keys[0]);
+    json.number(item.id);
+    json.raw(keys[1]);
+    json.string(item.title);
+    json.raw(keys[2]);
+    json.string(item.description);
+    json.raw(keys[3]);
+    json.string(item.dueDate);
+    json.raw(keys[4]);
+    json.string(TodoItem::priorityName(item.priority));
+    json.raw(keys[5]);
+    json.string(TodoItem::statusName(item.status));
+    json.raw(keys[6]);
+    json.number(static_cast<int64_t>(item.createdAt));
+    json.raw(keys[7]);
+    json.number(static_cast<int64_t>(item.updatedAt));
+    json.raw(keys[8]);
+}
+
+} // namespace
+
+template <typename Items>
+bool FileHandler::writeJSON(const Items& todos, bool ndjson) {
     std::string timestamp = getCurrentTimestamp();
-    std::string jsonFilename = "exports/todos_export_" + timestamp + ".json";
+    std::string jsonFilename = "exports/todos_export_" + timestamp + (ndjson ? ".ndjson" : ".json");
     
-    // Create exports directory if it doesn't exist
-    #ifdef _WIN32
-    system("mkdir exports 2>nul");
-    #else
-    system("mkdir -p exports 2>/dev/null");
-    #endif
+    std::error_code ec;
+    std::filesystem::create_directories("exports", ec);
     
-    std::ofstream jsonFile(jsonFilename);
-    if (!jsonFile.is_open()) {
+    JsonWriter json;
+    if (!json.open(jsonFilename)) {
         std::cerr << "❌ Could not create JSON file: " << jsonFilename << std::endl;
         return false;
     }
     
-    // Write JSON
-    jsonFile << "{\n";
-    jsonFile << "  \"todos\": [\n";
-    
-    for (size_t i = 0; i < todos.size(); i++) {
-        const auto& item = todos[i];
-        jsonFile << "    {\n";
-        jsonFile << "      \"id\": " << item.id << ",\n";
-        jsonFile << "      \"title\": \"" << item.title << "\",\n";
-        jsonFile << "      \"description\": \"" << item.description << "\",\n";
-        jsonFile << "      \"dueDate\": \"" << item.dueDate << "\",\n";
-        jsonFile << "      \"priority\": \"" << item.priorityToString() << "\",\n";
-        jsonFile << "      \"status\": \"" << item.statusToString() << "\",\n";
-        jsonFile << "      \"createdAt\": " << item.createdAt << ",\n";
-        jsonFile << "      \"updatedAt\": " << item.updatedAt << "\n";
-        jsonFile << "    }";
-        
-        if (i < todos.size() - 1) {
-            jsonFile << ",";
+    if (ndjson) {
+        // One object per line, so readers can stream it
+        for (const auto& item : todos) {
+            writeJSONItem(json, item, false);
+            json.raw("\n");
         }
-        jsonFile << "\n";
+    } else {
+        json.raw("{\n  \"todos\": [\n");
+        size_t remaining = todos.size();
+        for (const auto& item : todos) {
+            writeJSONItem(json, item, true);
+            json.raw(--remaining > 0 ? ",\n" : "\n");
+        }
+        json.raw("  ]\n}\n");
     }
     
-    jsonFile << "  ]\n";
-    jsonFile << "}\n";
-    
-    jsonFile.close();
+    if (!json.close()) {
+        std::cerr << "❌ Could not write JSON file: " << jsonFilename << std::endl;
+        return false;
+    }
     std::cout << "✅ JSON exported: " << jsonFilename << std::endl;
     return true;
 }
@@ -316,7 +634,13 @@ void FileHandler::showFileStats() const {
     if (stat(filename.c_str(), &fileInfo) == 0) {
         std::cout << "\n=== FILE STATISTICS ===\n";
         std::cout << "File: " << filename << std::endl;
-        std::cout << "Size: " << fileInfo.st_size << " bytes" << std::endl;
+        std::cout << "Size: " << fileInfo.st_size << " bytes";
+        BlockFile blocks;
+        if (blocks.open(filename)) {
+            std::cout << " (block-compressed, " << blocks.rawSize() << " bytes raw in "
+                      << blocks.blockCount() << " blocks)";
+        }
+        std::cout << std::endl;
         std::cout << "Last modified: " << std::ctime(&fileInfo.st_mtime);
         
         // Calculate file age
@@ -369,6 +693,68 @@ TodoItem FileHandler::deserializeTodo(const std::string& data) {
     return item;
 }
 
+// FNV-1a 64 over the whole file
+bool FileHandler::hashFile(const std::string& path, uint64_t& hash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    
+    hash = 14695981039346656037ull;
+    std::vector<char> buffer(64 * 1024);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        std::streamsize got = file.gcount();
+        for (std::streamsize i = 0; i < got; i++) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+    }
+    return file.eof();
+}
+
+bool FileHandler::syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+    #ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+    #else
+    return fsync(fileno(file)) == 0;
+    #endif
+}
+
+bool FileHandler::syncPath(const std::string& path, bool directory) {
+    #ifdef _WIN32
+    if (directory) return true; // NTFS metadata is journaled; nothing to sync
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _commit(fd) == 0;
+    _close(fd);
+    return ok;
+    #else
+    int fd = open(path.c_str(), directory ? O_RDONLY | O_DIRECTORY : O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+    #endif
+}
+
+// fsync the new file, rename it over the old one, then fsync the directory
+// so the rename itself survives a power loss
+bool FileHandler::replaceFile(const std::string& tempPath, const std::string& targetPath) {
+    if (!syncPath(tempPath)) {
+        return false;
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename(tempPath, targetPath, ec);
+    if (ec) {
+        return false;
+    }
+    
+    std::filesystem::path parent = std::filesystem::path(targetPath).parent_path();
+    syncPath(parent.empty() ? "." : parent.string(), true);
+    return true;
+}
+
 std::string FileHandler::getCurrentTimestamp() {
     std::time_t now = std::time(nullptr);
     std::tm* tm = std::localtime(&now);
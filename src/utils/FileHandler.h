@@ -3,35 +3,86 @@
 
 #include "../models/TodoItem.h"
 #include "../models/PriorityQueue.h"
+#include "../models/SlotMap.h"
+#include "MappedStore.h"
+#include "BackupCatalog.h"
+#include "BlockFile.h"
+#include "CsvWriter.h"
+#include "JsonWriter.h"
+#include <cstdio>
 #include <string>
 #include <vector>
 
 class FileHandler {
 private:
     std::string filename;
+    BackupCatalog catalog;
+    uint32_t compressionBlockSize; // 0 = write uncompressed
     
     // Helper methods for serialization - THESE WERE MISSING!
     std::string serializeTodo(const TodoItem& item);
     TodoItem deserializeTodo(const std::string& data);
     std::string getCurrentTimestamp();
     
+    // Writers shared by vectors and the slot map; Items is any range
+    // of todo-like items with size()
+    template <typename Items>
+    bool writeCSV(const Items& todos);
+    template <typename Items>
+    bool writeJSON(const Items& todos, bool ndjson);
+    template <typename Items>
+    bool writeBackup(const Items& todos, BackupKind kind);
+    
+    // TODO_DATA_V2 writer and atomic commit of the main store
+    template <typename Items>
+    bool commitStore(const Items& todos);
+    template <typename Items>
+    bool writeStore(const std::string& path, const Items& todos);
+    bool compressIfEnabled(const std::string& path);
+    
+    // Restore paths
+    bool restoreFromCatalog(uint32_t sequence);
+    bool restoreLegacyBackup(std::string backupFile);
+    static bool hashFile(const std::string& path, uint64_t& hash);
+    
+    // Durability helpers
+    static bool syncPath(const std::string& path, bool directory = false);
+    static bool replaceFile(const std::string& tempPath, const std::string& targetPath);
+    
 public:
     FileHandler(const std::string& filename = "todos.dat");
     
+    // Block-compress snapshots and backups written from now on; loading
+    // detects compressed files on its own
+    void setCompression(bool enabled, uint32_t blockSize = BlockFile::DEFAULT_BLOCK_SIZE);
+    bool isCompressionEnabled() const { return compressionBlockSize != 0; }
+    
     // Save and load operations
     bool saveToFile(const PriorityQueue& todos);
+    bool saveToFile(const std::vector<TodoItem>& todos);
+    bool saveToFile(const SlotMap& todos);
     bool loadFromFile(PriorityQueue& todos);
     
     // Backup and restore
-    bool createBackup(const std::vector<TodoItem>& todos);
+    bool createBackup(const std::vector<TodoItem>& todos, BackupKind kind = BackupKind::AUTO);
+    bool createBackup(const SlotMap& todos, BackupKind kind = BackupKind::AUTO);
     bool restoreFromBackup();
+    bool recordRemoval(int id); // tombstone for the next incremental backup
+    bool requireFullBackup();   // next backup is full (after bulk changes)
     
     // Export to different formats
     bool exportToCSV(const std::vector<TodoItem>& todos);
+    bool exportToCSV(const SlotMap& todos);
     bool exportToJSON(const std::vector<TodoItem>& todos);
+    bool exportToJSON(const SlotMap& todos);
+    bool exportToNDJSON(const std::vector<TodoItem>& todos); // one object per line
+    bool exportToNDJSON(const SlotMap& todos);
     
     // Statistics
     void showFileStats() const;
+    
+    // Flush and fsync an open stdio stream
+    static bool syncFile(std::FILE* file);
 };
 
 #endif // FILEHANDLER_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "GroupCommit.h"
+
+GroupCommit::GroupCommit(std::function<void()> commitFn, std::chrono::milliseconds window)
+    : commitFn(std::move(commitFn)), window(window),
+      requested(0), committed(0), commits(0), stopping(false) {
+    worker = std::thread(&GroupCommit::run, this);
+}
+
+GroupCommit::~GroupCommit() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    worker.join();
+}
+
+void GroupCommit::request() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        requested++;
+    }
+    wakeCv.notify_one();
+}
+
+void GroupCommit::waitDurable() {
+    std::unique_lock<std::mutex> lock(mtx);
+    uint64_t target = requested;
+    doneCv.wait(lock, [this, target] { return committed >= target; });
+}
+
+void GroupCommit::setWindow(std::chrono::milliseconds newWindow) {
+    std::lock_guard<std::mutex> lock(mtx);
+    window = newWindow;
+}
+
+std::chrono::milliseconds GroupCommit::getWindow() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return window;
+}
+
+size_t GroupCommit::commitCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return commits;
+}
+
+void GroupCommit::run() {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while (true) {
+        wakeCv.wait(lock, [this] { return stopping || requested > committed; });
+        if (requested == committed) {
+            return; // stopping with nothing left to commit
+        }
+
+        // Let more requests pile up before paying for the commit
+        if (!stopping) {
+            wakeCv.wait_for(lock, window, [this] { return stopping; });
+        }
+
+        uint64_t target = requested;
+        lock.unlock();
+        commitFn();
+        lock.lock();
+
+        committed = target;
+        commits++;
+        doneCv.notify_all();
+    }
+}
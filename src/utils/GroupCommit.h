@@ -0,0 +1,48 @@
+#ifndef GROUPCOMMIT_H
+#define GROUPCOMMIT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Coalesces durability requests that arrive within a short window into a
+// single commit (one fsync), run on a background thread.
+class GroupCommit {
+private:
+    std::function<void()> commitFn;
+    std::chrono::milliseconds window;
+
+    mutable std::mutex mtx;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    uint64_t requested;
+    uint64_t committed;
+    size_t commits;
+    bool stopping;
+    std::thread worker;
+
+    void run();
+
+public:
+    GroupCommit(std::function<void()> commitFn,
+                std::chrono::milliseconds window = std::chrono::milliseconds(10));
+    ~GroupCommit();
+
+    GroupCommit(const GroupCommit&) = delete;
+    GroupCommit& operator=(const GroupCommit&) = delete;
+
+    // Schedule a commit; returns immediately
+    void request();
+
+    // Block until everything requested so far has been committed
+    void waitDurable();
+
+    void setWindow(std::chrono::milliseconds newWindow);
+    std::chrono::milliseconds getWindow() const;
+    size_t commitCount() const;
+};
+
+#endif // GROUPCOMMIT_H
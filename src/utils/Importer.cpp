@@ -0,0 +1,489 @@
+#include "Importer.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+// ---- Columns shared by both schemas ----
+
+enum Column { ID, TITLE, DESCRIPTION, DUE_DATE, PRIORITY, STATUS, CREATED_AT, UPDATED_AT, UNKNOWN };
+
+// CSV header names and JSON keys as the exporters write them
+Column columnFor(std::string_view name) {
+    static const char* const csvNames[] = {
+        "ID", "Title", "Description", "Due Date", "Priority", "Status", "Created At", "Updated At"
+    };
+    static const char* const jsonNames[] = {
+        "id", "title", "description", "dueDate", "priority", "status", "createdAt", "updatedAt"
+    };
+    for (int c = ID; c < UNKNOWN; c++) {
+        if (name == csvNames[c] || name == jsonNames[c]) return static_cast<Column>(c);
+    }
+    return UNKNOWN;
+}
+
+bool parseNumber(std::string_view text, int64_t& value) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+// Store one value; false if it does not fit the column
+bool assign(TodoItem& item, Column column, std::string& value) {
+    int64_t number;
+    switch (column) {
+    case ID:
+        if (!parseNumber(value, number) || number < INT_MIN || number > INT_MAX) return false;
+        item.id = static_cast<int>(number);
+        return true;
+    case TITLE:
+        item.title.swap(value);
+        return true;
+    case DESCRIPTION:
+        item.description.swap(value);
+        return true;
+    case DUE_DATE:
+        item.dueDate.swap(value);
+        return true;
+    case PRIORITY:
+        return TodoItem::parsePriority(value, item.priority);
+    case STATUS:
+        return TodoItem::parseStatus(value, item.status);
+    case CREATED_AT:
+    case UPDATED_AT:
+        if (!parseNumber(value, number)) return false;
+        (column == CREATED_AT ? item.createdAt : item.updatedAt) = static_cast<std::time_t>(number);
+        return true;
+    default:
+        return true; // unknown columns are ignored
+    }
+}
+
+// ---- CSV ----
+
+// Read one field; leaves pos on the delimiter that ended it
+bool readCsvField(const char*& pos, const char* end, std::string& out) {
+    out.clear();
+    if (pos < end && *pos == '"') {
+        pos++;
+        while (true) {
+            const char* quote = static_cast<const char*>(std::memchr(pos, '"', end - pos));
+            if (!quote) return false; // unterminated
+            out.append(pos, quote);
+            pos = quote + 1;
+            if (pos < end && *pos == '"') { // doubled quote
+                out.push_back('"');
+                pos++;
+                continue;
+            }
+            break;
+        }
+        return pos == end || *pos == ',' || *pos == '\n' || *pos == '\r';
+    }
+
+    const char* start = pos;
+    while (pos < end && *pos != ',' && *pos != '\n' && *pos != '\r') pos++;
+    out.assign(start, pos);
+    return true;
+}
+
+// Read one record into fields; false on broken quoting
+bool readCsvRecord(const char*& pos, const char* end, std::vector<std::string>& fields) {
+    size_t count = 0;
+    while (true) {
+        if (fields.size() <= count) fields.emplace_back();
+        if (!readCsvField(pos, end, fields[count++])) {
+            fields.resize(count);
+            return false;
+        }
+        if (pos < end && *pos == ',') {
+            pos++;
+            continue;
+        }
+        break;
+    }
+    fields.resize(count);
+    if (pos < end && *pos == '\r') pos++;
+    if (pos < end && *pos == '\n') pos++;
+    return true;
+}
+
+void parseCsvChunk(const char* pos, const char* end, const std::vector<Column>& columns,
+                   std::vector<TodoItem>& out, size_t& skipped) {
+    std::vector<std::string> fields;
+    while (pos < end) {
+        if (*pos == '\n' || *pos == '\r') { // blank line
+            pos++;
+            continue;
+        }
+
+        if (!readCsvRecord(pos, end, fields)) {
+            skipped++;
+            const char* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+            pos = newline ? newline + 1 : end;
+            continue;
+        }
+
+        TodoItem item;
+        bool valid = true;
+        for (size_t i = 0; i < fields.size() && i < columns.size(); i++) {
+            valid = assign(item, columns[i], fields[i]) && valid;
+        }
+        if (valid) {
+            out.push_back(std::move(item));
+        } else {
+            skipped++;
+        }
+    }
+}
+
+// ---- JSON / NDJSON ----
+
+inline void skipSpace(const char*& pos, const char* end) {
+    while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) pos++;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool readHex4(const char*& pos, const char* end, uint32_t& code) {
+    if (end - pos < 4) return false;
+    code = 0;
+    for (int i = 0; i < 4; i++) {
+        int digit = hexValue(*pos++);
+        if (digit < 0) return false;
+        code = code * 16 + digit;
+    }
+    return true;
+}
+
+void appendUtf8(std::string& out, uint32_t code) {
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+// pos is on the opening quote
+bool readJsonString(const char*& pos, const char* end, std::string& out) {
+    out.clear();
+    pos++;
+    while (true) {
+        const char* run = pos;
+        while (pos < end && *pos != '"' && *pos != '\\') pos++;
+        out.append(run, pos);
+        if (pos >= end) return false;
+        if (*pos++ == '"') return true;
+
+        if (pos >= end) return false;
+        switch (*pos++) {
+        case '"':  out.push_back('"'); break;
+        case '\\': out.push_back('\\'); break;
+        case '/':  out.push_back('/'); break;
+        case 'b':  out.push_back('\b'); break;
+        case 'f':  out.push_back('\f'); break;
+        case 'n':  out.push_back('\n'); break;
+        case 'r':  out.push_back('\r'); break;
+        case 't':  out.push_back('\t'); break;
+        case 'u': {
+            uint32_t code;
+            if (!readHex4(pos, end, code)) return false;
+            if (code >= 0xD800 && code <= 0xDBFF) { // surrogate pair
+                uint32_t low;
+                if (end - pos < 6 || pos[0] != '\\' || pos[1] != 'u') return false;
+                pos += 2;
+                if (!readHex4(pos, end, low) || low < 0xDC00 || low > 0xDFFF) return false;
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            appendUtf8(out, code);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+// pos is on '{'; objects are flat: string keys, string or scalar values
+bool parseJsonObject(const char*& pos, const char* end, TodoItem& item, bool& valid,
+                     std::string& key, std::string& value) {
+    pos++;
+    while (true) {
+        skipSpace(pos, end);
+        if (pos >= end) return false;
+        if (*pos == '}') {
+            pos++;
+            return true;
+        }
+        if (*pos != '"' || !readJsonString(pos, end, key)) return false;
+        skipSpace(pos, end);
+        if (pos >= end || *pos++ != ':') return false;
+        skipSpace(pos, end);
+        if (pos >= end) return false;
+
+        bool isNull = false;
+        if (*pos == '"') {
+            if (!readJsonString(pos, end, value)) return false;
+        } else {
+            const char* start = pos;
+            while (pos < end && *pos != ',' && *pos != '}' && *pos != ' ' &&
+                   *pos != '\n' && *pos != '\r' && *pos != '\t') {
+                if (*pos == '{' || *pos == '[' || *pos == '"') return false; // nested values
+                pos++;
+            }
+            value.assign(start, pos);
+            isNull = value == "null";
+            if (value.empty()) return false;
+        }
+
+        if (!isNull && !assign(item, columnFor(key), value)) valid = false;
+
+        skipSpace(pos, end);
+        if (pos < end && *pos == ',') {
+            pos++;
+            continue;
+        }
+        if (pos < end && *pos == '}') {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+}
+
+// Between objects there are only brackets, commas and whitespace, so the
+// next '{' is always the next record
+void parseJsonChunk(const char* pos, const char* end, std::vector<TodoItem>& out, size_t& skipped) {
+    std::string key, value;
+    while (pos < end) {
+        const char* open = static_cast<const char*>(std::memchr(pos, '{', end - pos));
+        if (!open) break;
+        pos = open;
+
+        TodoItem item;
+        bool valid = true;
+        if (!parseJsonObject(pos, end, item, valid, key, value)) {
+            skipped++;
+            pos = open + 1;
+            continue;
+        }
+        if (valid) {
+            out.push_back(std::move(item));
+        } else {
+            skipped++;
+        }
+    }
+}
+
+// ---- Chunking ----
+
+// Quotes that open or close a string. In CSV a doubled quote toggles twice;
+// in JSON a quote after an odd run of backslashes is escaped. memchr keeps
+// this pass at memory speed on text with few quotes.
+size_t countQuotes(const char* pos, const char* end, bool json) {
+    const char* chunkStart = pos;
+    size_t quotes = 0;
+    while (pos < end) {
+        const char* quote = static_cast<const char*>(std::memchr(pos, '"', end - pos));
+        if (!quote) break;
+        if (json) {
+            const char* run = quote;
+            while (run > chunkStart && run[-1] == '\\') run--;
+            if ((quote - run) % 2 == 0) quotes++;
+        } else {
+            quotes++;
+        }
+        pos = quote + 1;
+    }
+    return quotes;
+}
+
+// First record start at or after pos, given whether pos is inside a string
+const char* findRecordStart(const char* pos, const char* end, bool inString, bool json) {
+    for (; pos < end; pos++) {
+        char c = *pos;
+        if (inString) {
+            if (json && c == '\\') {
+                pos++;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (json ? c == '{' : c == '\n') {
+            return json ? pos : pos + 1;
+        }
+    }
+    return end;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+} // namespace
+
+ImportFormat Importer::detectFormat(const std::string& path, const std::string& data) {
+    std::string lower = path;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (endsWith(lower, ".csv")) return ImportFormat::CSV;
+    if (endsWith(lower, ".ndjson") || endsWith(lower, ".jsonl")) return ImportFormat::NDJSON;
+    if (endsWith(lower, ".json")) return ImportFormat::JSON;
+
+    size_t first = data.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return ImportFormat::CSV;
+    if (data[first] == '[') return ImportFormat::JSON;
+    if (data[first] == '{') {
+        // A complete object on the first line means one object per line
+        size_t newline = data.find('\n', first);
+        std::string line = data.substr(first, newline == std::string::npos ? std::string::npos : newline - first);
+        size_t last = line.find_last_not_of(" \t\r");
+        return (last != std::string::npos && line[last] == '}') ? ImportFormat::NDJSON : ImportFormat::JSON;
+    }
+    return ImportFormat::CSV;
+}
+
+const char* Importer::formatName(ImportFormat format) {
+    switch (format) {
+    case ImportFormat::CSV:    return "CSV";
+    case ImportFormat::JSON:   return "JSON";
+    case ImportFormat::NDJSON: return "NDJSON";
+    default:                   return "Auto";
+    }
+}
+
+bool Importer::importFile(const std::string& path, std::vector<TodoItem>& items,
+                          ImportStats& stats, ImportFormat format, ThreadPool& pool) {
+    stats = ImportStats();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "❌ Could not open import file: " << path << std::endl;
+        return false;
+    }
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(&data[0], data.size())) {
+        std::cerr << "❌ Could not read import file: " << path << std::endl;
+        return false;
+    }
+    file.close();
+
+    if (format == ImportFormat::AUTO) {
+        format = detectFormat(path, data);
+    }
+    stats.format = format;
+    bool json = format != ImportFormat::CSV;
+
+    const char* begin = data.data();
+    const char* end = begin + data.size();
+    if (data.compare(0, 3, "\xEF\xBB\xBF") == 0) begin += 3; // UTF-8 BOM
+
+    // Records start after the CSV header or the opening '[' of the JSON array
+    std::vector<Column> columns;
+    if (format == ImportFormat::CSV) {
+        std::vector<std::string> header;
+        if (!readCsvRecord(begin, end, header)) {
+            std::cerr << "❌ Invalid CSV header in " << path << std::endl;
+            return false;
+        }
+        for (const auto& name : header) {
+            columns.push_back(columnFor(name));
+        }
+    } else if (format == ImportFormat::JSON) {
+        const char* array = static_cast<const char*>(std::memchr(begin, '[', end - begin));
+        if (!array) {
+            std::cerr << "❌ No todo array found in " << path << std::endl;
+            return false;
+        }
+        begin = array + 1;
+    }
+
+    // 1. Even split points; never right after a backslash, so an escape
+    //    sequence is never cut in two
+    size_t length = end - begin;
+    size_t chunks = std::max<size_t>(1, std::min(pool.size() * 4, length / MIN_CHUNK_BYTES));
+    std::vector<const char*> splits(chunks + 1);
+    splits[0] = begin;
+    splits[chunks] = end;
+    for (size_t k = 1; k < chunks; k++) {
+        const char* split = begin + length * k / chunks;
+        while (json && split < end && split[-1] == '\\') split++;
+        splits[k] = std::max(split, splits[k - 1]);
+    }
+
+    std::vector<size_t> quotes(chunks);
+    pool.parallelFor(chunks, [&](size_t k) {
+        quotes[k] = countQuotes(splits[k], splits[k + 1], json);
+    });
+
+    // 2. Quote parity before each split point tells if it is inside a string
+    std::vector<const char*> starts(chunks + 1);
+    starts[0] = begin;
+    starts[chunks] = end;
+    std::vector<bool> inString(chunks, false);
+    size_t seen = 0;
+    for (size_t k = 0; k < chunks; k++) {
+        inString[k] = seen % 2 == 1;
+        seen += quotes[k];
+    }
+    pool.parallelFor(chunks - 1, [&](size_t i) {
+        size_t k = i + 1;
+        starts[k] = findRecordStart(splits[k], end, inString[k], json);
+    });
+
+    // 3. Parse every chunk independently
+    std::vector<std::vector<TodoItem>> parsed(chunks);
+    std::vector<size_t> skipped(chunks, 0);
+    pool.parallelFor(chunks, [&](size_t k) {
+        if (json) {
+            parseJsonChunk(starts[k], starts[k + 1], parsed[k], skipped[k]);
+        } else {
+            parseCsvChunk(starts[k], starts[k + 1], columns, parsed[k], skipped[k]);
+        }
+    });
+
+    // Release the input before gathering, and each chunk as it is moved,
+    // so peak memory stays near one copy of the items
+    std::string().swap(data);
+    size_t total = 0;
+    for (size_t k = 0; k < chunks; k++) {
+        total += parsed[k].size();
+        stats.skipped += skipped[k];
+    }
+    items.reserve(items.size() + total);
+    for (auto& chunk : parsed) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(items));
+        std::vector<TodoItem>().swap(chunk);
+    }
+
+    stats.records = total;
+    stats.chunks = chunks;
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include "../models/TodoItem.h"
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+
+enum class ImportFormat {
+    AUTO,   // From the extension, else from the content
+    CSV,    // exportToCSV layout: header row, RFC 4180 quoting
+    JSON,   // exportToJSON layout: {"todos": [ {...}, ... ]} or a bare array
+    NDJSON  // exportToNDJSON layout: one object per line
+};
+
+struct ImportStats {
+    ImportFormat format = ImportFormat::AUTO;
+    size_t records = 0;  // todos parsed
+    size_t skipped = 0;  // malformed records left out
+    size_t chunks = 0;   // pieces parsed in parallel
+};
+
+// Parallel bulk reader for the export formats. The file is cut into chunks
+// at record boundaries and each chunk is parsed on its own thread:
+//
+//  1. split at even offsets, counting quotes per chunk (parallel)
+//  2. a prefix sum of quote parity tells whether each split point is inside
+//     a quoted string, so every chunk can find its first real record start
+//     without scanning the chunks before it (parallel)
+//  3. parse each chunk into its own vector, then concatenate in file order
+//
+// Ids are kept as written; a missing id is left as 0 for the caller to assign.
+class Importer {
+public:
+    static bool importFile(const std::string& path, std::vector<TodoItem>& items,
+                           ImportStats& stats, ImportFormat format = ImportFormat::AUTO,
+                           ThreadPool& pool = ThreadPool::shared());
+
+    static ImportFormat detectFormat(const std::string& path, const std::string& data);
+    static const char* formatName(ImportFormat format);
+};
+
+#endif // IMPORTER_H
@@ -0,0 +1,286 @@
+#include "Journal.h"
+#include "FileHandler.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+Journal::Journal(const std::string& filename)
+    : filename(filename), file(nullptr), records(0), bytes(0) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filename, ec);
+    if (!ec) {
+        bytes = size;
+    }
+}
+
+Journal::~Journal() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool Journal::open() {
+    if (file) return true;
+
+    file = std::fopen(filename.c_str(), "ab");
+    if (!file) {
+        std::cerr << "Error: Could not open journal " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Journal::putU32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void Journal::putI64(std::string& out, int64_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void Journal::putString(std::string& out, const std::string& value) {
+    putU32(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+// FNV-1a, enough to detect a torn or garbled tail record
+uint32_t Journal::checksum(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool Journal::appendRecord(Op op, const std::string& payload) {
+    std::string record;
+    record.reserve(payload.size() + 9);
+    record.push_back(static_cast<char>(op));
+    putU32(record, static_cast<uint32_t>(payload.size()));
+    record.append(payload);
+    putU32(record, checksum(record.data(), record.size()));
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (!open()) return false;
+    if (std::fwrite(record.data(), 1, record.size(), file) != record.size()) {
+        std::cerr << "Error: Could not append to journal " << filename << std::endl;
+        return false;
+    }
+    std::fflush(file);
+
+    records++;
+    bytes += record.size();
+    return true;
+}
+
+bool Journal::appendUpsert(const TodoItem& item) {
+    std::string payload;
+    payload.reserve(40 + item.title.size() + item.description.size() + item.dueDate.size());
+    putU32(payload, static_cast<uint32_t>(item.id));
+    payload.push_back(static_cast<char>(item.priority));
+    payload.push_back(static_cast<char>(item.status));
+    putI64(payload, static_cast<int64_t>(item.createdAt));
+    putI64(payload, static_cast<int64_t>(item.updatedAt));
+    putString(payload, item.title);
+    putString(payload, item.description);
+    putString(payload, item.dueDate);
+    return appendRecord(Op::UPSERT, payload);
+}
+
+bool Journal::appendRemove(int id) {
+    std::string payload;
+    putU32(payload, static_cast<uint32_t>(id));
+    return appendRecord(Op::REMOVE, payload);
+}
+
+bool Journal::appendStatus(int id, Status status, std::time_t updatedAt) {
+    std::string payload;
+    putU32(payload, static_cast<uint32_t>(id));
+    payload.push_back(static_cast<char>(status));
+    putI64(payload, static_cast<int64_t>(updatedAt));
+    return appendRecord(Op::SET_STATUS, payload);
+}
+
+namespace {
+
+// Bounds-checked reader over one record payload
+class PayloadReader {
+private:
+    const char* pos;
+    const char* end;
+
+public:
+    PayloadReader(const char* data, size_t length) : pos(data), end(data + length) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (static_cast<size_t>(end - pos) < sizeof(T)) return false;
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string& value) {
+        uint32_t length;
+        if (!get(length) || static_cast<size_t>(end - pos) < length) return false;
+        value.assign(pos, length);
+        pos += length;
+        return true;
+    }
+};
+
+} // namespace
+
+size_t Journal::replay(std::vector<TodoItem>& todos) {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    records = 0;
+    bytes = 0;
+
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        return 0;
+    }
+
+    std::unordered_map<int, size_t> slots;
+    slots.reserve(todos.size());
+    for (size_t i = 0; i < todos.size(); i++) {
+        slots[todos[i].id] = i;
+    }
+
+    std::string record;
+    uint64_t validBytes = 0;
+    std::vector<bool> removed(todos.size(), false);
+    size_t removedCount = 0;
+
+    while (true) {
+        char header[5];
+        if (!in.read(header, sizeof(header))) break;
+
+        uint32_t length;
+        std::memcpy(&length, header + 1, sizeof(length));
+        if (length > MAX_RECORD_BYTES) break;
+
+        record.assign(header, sizeof(header));
+        record.resize(sizeof(header) + length);
+        uint32_t stored;
+        if (!in.read(&record[sizeof(header)], length) ||
+            !in.read(reinterpret_cast<char*>(&stored), sizeof(stored)) ||
+            stored != checksum(record.data(), record.size())) {
+            break;
+        }
+
+        PayloadReader reader(record.data() + sizeof(header), length);
+        Op op = static_cast<Op>(header[0]);
+        int32_t id = 0;
+        if (!reader.get(id)) break;
+
+        auto it = slots.find(id);
+        bool live = it != slots.end() && !removed[it->second];
+
+        if (op == Op::UPSERT) {
+            TodoItem item;
+            uint8_t priority, status;
+            int64_t createdAt, updatedAt;
+            if (!reader.get(priority) || !reader.get(status) ||
+                !reader.get(createdAt) || !reader.get(updatedAt) ||
+                !reader.getString(item.title) || !reader.getString(item.description) ||
+                !reader.getString(item.dueDate)) {
+                break;
+            }
+            item.id = id;
+            item.priority = static_cast<Priority>(priority);
+            item.status = static_cast<Status>(status);
+            item.createdAt = static_cast<std::time_t>(createdAt);
+            item.updatedAt = static_cast<std::time_t>(updatedAt);
+
+            if (live) {
+                todos[it->second] = std::move(item);
+            } else {
+                slots[id] = todos.size();
+                todos.push_back(std::move(item));
+                removed.push_back(false);
+            }
+        } else if (op == Op::REMOVE) {
+            if (live) {
+                removed[it->second] = true;
+                removedCount++;
+                slots.erase(it);
+            }
+        } else if (op == Op::SET_STATUS) {
+            uint8_t status;
+            int64_t updatedAt;
+            if (!reader.get(status) || !reader.get(updatedAt)) break;
+            if (live) {
+                todos[it->second].status = static_cast<Status>(status);
+                todos[it->second].updatedAt = static_cast<std::time_t>(updatedAt);
+            }
+        } else {
+            break;
+        }
+
+        records++;
+        validBytes += record.size() + sizeof(stored);
+    }
+    in.close();
+
+    // Compact removed items in a single pass
+    if (removedCount > 0) {
+        size_t out = 0;
+        for (size_t i = 0; i < todos.size(); i++) {
+            if (!removed[i]) {
+                if (out != i) todos[out] = std::move(todos[i]);
+                out++;
+            }
+        }
+        todos.resize(out);
+    }
+
+    // Cut off a torn tail so new records are not appended after garbage
+    std::error_code ec;
+    if (std::filesystem::file_size(filename, ec) != validBytes && !ec) {
+        std::cout << "⚠️  Journal tail was damaged, discarding incomplete record." << std::endl;
+        std::filesystem::resize_file(filename, validBytes, ec);
+    }
+    bytes = validBytes;
+
+    if (records > 0) {
+        std::cout << "🔁 Replayed " << records << " journal records from " << filename << std::endl;
+    }
+    return records;
+}
+
+bool Journal::reset() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not reset journal " << filename << std::endl;
+        return false;
+    }
+
+    records = 0;
+    bytes = 0;
+    return true;
+}
+
+bool Journal::sync() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (!file) return true;
+
+    if (!FileHandler::syncFile(file)) {
+        std::cerr << "Error: Could not sync journal " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "../models/TodoItem.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Append-only write-ahead journal that sits next to the snapshot file.
+// Every mutation appends one small record; on startup the records are
+// replayed over the last snapshot written by FileHandler.
+//
+// Record layout: [op:u8][payload length:u32][payload][checksum:u32]
+class Journal {
+public:
+    enum class Op : uint8_t {
+        UPSERT = 1,     // Full item (add / update)
+        REMOVE = 2,     // id only
+        SET_STATUS = 3  // id, status, updatedAt
+    };
+
+private:
+    std::string filename;
+    std::FILE* file;
+    std::mutex fileMutex; // appends and background syncs share the handle
+    size_t records;
+    uint64_t bytes;
+
+    bool open();
+    bool appendRecord(Op op, const std::string& payload);
+
+    // Binary encoding helpers
+    static void putU32(std::string& out, uint32_t value);
+    static void putI64(std::string& out, int64_t value);
+    static void putString(std::string& out, const std::string& value);
+    static uint32_t checksum(const char* data, size_t length);
+
+public:
+    // Checkpoint once the journal grows past this many bytes
+    static const uint64_t CHECKPOINT_BYTES = 4 * 1024 * 1024;
+    // Anything larger than this in a length field is treated as corruption
+    static const uint32_t MAX_RECORD_BYTES = 16 * 1024 * 1024;
+
+    Journal(const std::string& filename = "todos.journal");
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Append operations - O(1) in the size of the store
+    bool appendUpsert(const TodoItem& item);
+    bool appendRemove(int id);
+    bool appendStatus(int id, Status status, std::time_t updatedAt);
+
+    // Apply all intact records to todos; a torn tail is cut off
+    size_t replay(std::vector<TodoItem>& todos);
+
+    // Drop all records (called after a snapshot has been written)
+    bool reset();
+
+    // Force appended records to stable storage (fsync)
+    bool sync();
+
+    size_t recordCount() const { return records; }
+    uint64_t sizeInBytes() const { return bytes; }
+    bool needsCheckpoint() const { return bytes >= CHECKPOINT_BYTES; }
+    const std::string& getFilename() const { return filename; }
+};
+
+#endif // JOURNAL_H
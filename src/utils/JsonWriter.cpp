@@ -0,0 +1,209 @@
+#include "JsonWriter.h"
+#include <charconv>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JSON_WRITER_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+inline bool needsEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+// Length of the prefix that can be copied without escaping
+size_t scanScalar(const char* text, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (needsEscape(static_cast<unsigned char>(text[i]))) return i;
+    }
+    return length;
+}
+
+#ifdef JSON_WRITER_X86
+
+inline unsigned firstBit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline unsigned sse2Mask(const char* text) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+    // min(b, 0x1F) == b  <=>  b <= 0x1F (unsigned)
+    __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')),
+                     _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))),
+        _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(0x1F)), bytes));
+    return static_cast<unsigned>(_mm_movemask_epi8(hits));
+}
+
+// Short strings (most titles) are not worth a vector setup
+size_t scanSSE2(const char* text, size_t length) {
+    if (length < 16) return scanScalar(text, length);
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        unsigned mask = sse2Mask(text + i);
+        if (mask) return i + firstBit(mask);
+    }
+    if (i == length) return length;
+
+    // Overlapping last load instead of a scalar tail
+    size_t last = length - 16;
+    unsigned mask = sse2Mask(text + last) >> (i - last);
+    return mask ? i + firstBit(mask) : length;
+}
+
+#if defined(__GNUC__)
+#define JSON_WRITER_AVX2 1
+
+__attribute__((target("avx2")))
+inline unsigned avx2Mask(const char* text) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text));
+    __m256i hits = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')),
+                        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))),
+        _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, _mm256_set1_epi8(0x1F)), bytes));
+    return static_cast<unsigned>(_mm256_movemask_epi8(hits));
+}
+
+__attribute__((target("avx2")))
+size_t scanAVX2Long(const char* text, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        unsigned mask = avx2Mask(text + i);
+        if (mask) return i + firstBit(mask);
+    }
+    if (i == length) return length;
+
+    size_t last = length - 32;
+    unsigned mask = avx2Mask(text + last) >> (i - last);
+    return mask ? i + firstBit(mask) : length;
+}
+
+// Strings under 32 bytes stay on SSE2 so the 256-bit unit is never touched
+size_t scanAVX2(const char* text, size_t length) {
+    if (length < 32) return scanSSE2(text, length);
+    return scanAVX2Long(text, length);
+}
+#endif // __GNUC__
+
+#endif // JSON_WRITER_X86
+
+using ScanFn = size_t (*)(const char*, size_t);
+
+bool kernelSupported(JsonWriter::Kernel kernel) {
+    switch (kernel) {
+    case JsonWriter::Kernel::SCALAR:
+        return true;
+#ifdef JSON_WRITER_X86
+    case JsonWriter::Kernel::SSE2:
+        return true; // baseline on x86-64
+#ifdef JSON_WRITER_AVX2
+    case JsonWriter::Kernel::AVX2:
+        __builtin_cpu_init(); // may run before other static initializers
+        return __builtin_cpu_supports("avx2");
+#endif
+#endif
+    default:
+        return false;
+    }
+}
+
+ScanFn scanFor(JsonWriter::Kernel kernel) {
+    switch (kernel) {
+#ifdef JSON_WRITER_X86
+    case JsonWriter::Kernel::SSE2:
+        return scanSSE2;
+#ifdef JSON_WRITER_AVX2
+    case JsonWriter::Kernel::AVX2:
+        return scanAVX2;
+#endif
+#endif
+    default:
+        return scanScalar;
+    }
+}
+
+JsonWriter::Kernel bestKernel() {
+    if (kernelSupported(JsonWriter::Kernel::AVX2)) return JsonWriter::Kernel::AVX2;
+    if (kernelSupported(JsonWriter::Kernel::SSE2)) return JsonWriter::Kernel::SSE2;
+    return JsonWriter::Kernel::SCALAR;
+}
+
+JsonWriter::Kernel currentKernel = bestKernel();
+ScanFn scan = scanFor(currentKernel);
+
+} // namespace
+
+void JsonWriter::string(std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+
+    out.put('"');
+
+    const char* pos = text.data();
+    size_t remaining = text.size();
+    while (remaining > 0) {
+        size_t clean = scan(pos, remaining);
+        out.append(pos, clean);
+        pos += clean;
+        remaining -= clean;
+        if (remaining == 0) break;
+
+        unsigned char c = static_cast<unsigned char>(*pos++);
+        remaining--;
+        char* dst = out.reserve(6);
+        *dst++ = '\\';
+        switch (c) {
+        case '"':  *dst++ = '"'; break;
+        case '\\': *dst++ = '\\'; break;
+        case '\b': *dst++ = 'b'; break;
+        case '\f': *dst++ = 'f'; break;
+        case '\n': *dst++ = 'n'; break;
+        case '\r': *dst++ = 'r'; break;
+        case '\t': *dst++ = 't'; break;
+        default:
+            *dst++ = 'u';
+            *dst++ = '0';
+            *dst++ = '0';
+            *dst++ = HEX[c >> 4];
+            *dst++ = HEX[c & 0xF];
+        }
+        out.commit(dst);
+    }
+
+    out.put('"');
+}
+
+void JsonWriter::number(int64_t value) {
+    char* dst = out.reserve(24);
+    out.commit(std::to_chars(dst, dst + 24, value).ptr);
+}
+
+JsonWriter::Kernel JsonWriter::activeKernel() {
+    return currentKernel;
+}
+
+bool JsonWriter::useKernel(Kernel kernel) {
+    if (!kernelSupported(kernel)) return false;
+    currentKernel = kernel;
+    scan = scanFor(kernel);
+    return true;
+}
+
+const char* JsonWriter::kernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::SSE2: return "SSE2";
+    case Kernel::AVX2: return "AVX2";
+    default:           return "scalar";
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include "BufferedFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Streaming JSON writer. Output is formatted into a reusable 1 MB block
+// and flushed in large writes; strings are escaped per RFC 8259.
+//
+// The escape scan looks for '"', '\\' and control bytes 16 or 32 bytes at
+// a time (SSE2 / AVX2, chosen at runtime) and copies clean runs with one
+// memcpy, so typical text costs about as much as copying it.
+class JsonWriter {
+public:
+    enum class Kernel { SCALAR, SSE2, AVX2 };
+
+private:
+    BufferedFile out;
+
+public:
+    static const size_t BUFFER_SIZE = BufferedFile::BUFFER_SIZE;
+
+    bool open(const std::string& path) { return out.open(path); }
+    bool close() { return out.close(); } // flushes; false if any write failed
+
+    // Text written as is (punctuation, keys, indentation)
+    void raw(std::string_view text) { out.append(text.data(), text.size()); }
+    // Quoted and escaped string value
+    void string(std::string_view text);
+    void number(int64_t value);
+
+    bool good() const { return out.good(); }
+
+    // Escape scan selection; the best supported kernel is used by default
+    static Kernel activeKernel();
+    static bool useKernel(Kernel kernel); // false if the CPU lacks it
+    static const char* kernelName(Kernel kernel);
+};
+
+#endif // JSONWRITER_H
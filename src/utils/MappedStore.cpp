@@ -0,0 +1,219 @@
+#include "MappedStore.h"
+#include "BlockFile.h"
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char MappedStore::MAGIC[16] = "TODO_DATA_V2";
+
+MappedStore::MappedStore()
+    : data(nullptr), length(0), header(nullptr),
+      records(nullptr), heap(nullptr), index(nullptr) {
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#endif
+}
+
+MappedStore::~MappedStore() {
+    close();
+}
+
+bool MappedStore::open(const std::string& path) {
+    close();
+    if (BlockFile::isBlockFile(path)) {
+        return openCompressed(path);
+    }
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    data = mapped == MAP_FAILED ? nullptr : static_cast<const char*>(mapped);
+#endif
+
+    if (!data || !validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedStore::openCompressed(const std::string& path) {
+    BlockFile blocks;
+    if (!blocks.open(path) || blocks.rawSize() == 0) return false;
+
+    // The record table and heap are read in place, so the whole image is
+    // inflated here; per-block access is only through BlockFile::readBlock
+    inflated.resize(static_cast<size_t>(blocks.rawSize()));
+    if (!blocks.readAll(inflated.data())) {
+        close();
+        return false;
+    }
+    data = inflated.data();
+    length = inflated.size();
+
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedStore::close() {
+    if (!inflated.empty()) {
+        data = nullptr; // not a mapping
+        inflated.clear();
+        inflated.shrink_to_fit();
+    }
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (data) munmap(const_cast<char*>(data), length);
+#endif
+    data = nullptr;
+    length = 0;
+    header = nullptr;
+    records = nullptr;
+    heap = nullptr;
+    index = nullptr;
+}
+
+bool MappedStore::isV2File(const std::string& path) {
+    if (BlockFile::isBlockFile(path)) return true;
+
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!file.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// Check every section and string reference once, so later reads can skip it
+bool MappedStore::validate() {
+    if (length < sizeof(StoreHeader)) return false;
+
+    const StoreHeader* h = reinterpret_cast<const StoreHeader*>(data);
+    if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        h->version != VERSION || h->recordSize != sizeof(StoreRecord)) {
+        return false;
+    }
+
+    uint64_t count = h->count;
+    if (h->recordsOffset > length || h->heapOffset > length ||
+        h->heapSize > length || h->indexOffset > length ||
+        count > length / sizeof(StoreRecord) ||
+        h->recordsOffset % alignof(StoreRecord) != 0 ||
+        h->indexOffset % alignof(StoreIndexEntry) != 0 ||
+        h->recordsOffset + count * sizeof(StoreRecord) > h->heapOffset ||
+        h->heapOffset + h->heapSize > h->indexOffset ||
+        h->indexOffset + count * sizeof(StoreIndexEntry) > length) {
+        return false;
+    }
+
+    const StoreRecord* recs = reinterpret_cast<const StoreRecord*>(data + h->recordsOffset);
+    for (uint64_t i = 0; i < count; i++) {
+        const StoreRecord& r = recs[i];
+        if (uint64_t(r.titleOffset) + r.titleLength > h->heapSize ||
+            uint64_t(r.descriptionOffset) + r.descriptionLength > h->heapSize ||
+            uint64_t(r.dueDateOffset) + r.dueDateLength > h->heapSize ||
+            r.priority > static_cast<uint8_t>(Priority::URGENT) ||
+            r.status > static_cast<uint8_t>(Status::COMPLETED)) {
+            return false;
+        }
+    }
+
+    const StoreIndexEntry* idx = reinterpret_cast<const StoreIndexEntry*>(data + h->indexOffset);
+    for (uint64_t i = 0; i < count; i++) {
+        if (idx[i].record >= count || (i > 0 && idx[i - 1].id > idx[i].id)) {
+            return false;
+        }
+    }
+
+    header = h;
+    records = recs;
+    heap = data + h->heapOffset;
+    index = idx;
+    return true;
+}
+
+std::string_view MappedStore::trailer() const {
+    if (!header) return std::string_view();
+    size_t end = static_cast<size_t>(header->indexOffset + header->count * sizeof(StoreIndexEntry));
+    return std::string_view(data + end, length - end);
+}
+
+long MappedStore::findById(int id) const {
+    size_t left = 0, right = size();
+
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        if (index[mid].id < id) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+
+    if (left < size() && index[left].id == id) {
+        return static_cast<long>(index[left].record);
+    }
+    return -1;
+}
+
+TodoItemView MappedStore::view(size_t i) const {
+    const StoreRecord& r = records[i];
+
+    TodoItemView item;
+    item.id = r.id;
+    item.title = string(r.titleOffset, r.titleLength);
+    item.description = string(r.descriptionOffset, r.descriptionLength);
+    item.dueDate = string(r.dueDateOffset, r.dueDateLength);
+    item.priority = static_cast<Priority>(r.priority);
+    item.status = static_cast<Status>(r.status);
+    item.createdAt = static_cast<std::time_t>(r.createdAt);
+    item.updatedAt = static_cast<std::time_t>(r.updatedAt);
+    return item;
+}
+
+TodoItem MappedStore::materialize(size_t i) const {
+    return view(i).materialize();
+}
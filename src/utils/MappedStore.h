@@ -0,0 +1,114 @@
+#ifndef MAPPEDSTORE_H
+#define MAPPEDSTORE_H
+
+#include "../models/TodoItem.h"
+#include "../models/TodoItemView.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// On-disk layout of the TODO_DATA_V2 store:
+//
+//   [StoreHeader][StoreRecord x count][string heap][StoreIndexEntry x count]
+//
+// Records are fixed width; strings live in the heap and are referenced by
+// offset/length. The footer index is sorted by id for binary search.
+// All integers are little-endian (the byte order of every supported host).
+struct StoreHeader {
+    char magic[16];          // "TODO_DATA_V2", zero padded
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;
+    uint64_t recordsOffset;
+    uint64_t heapOffset;
+    uint64_t heapSize;
+    uint64_t indexOffset;
+    int64_t savedAt;
+};
+
+struct StoreRecord {
+    int32_t id;
+    uint8_t priority;
+    uint8_t status;
+    uint16_t reserved;
+    int64_t createdAt;
+    int64_t updatedAt;
+    uint32_t titleOffset;
+    uint32_t titleLength;
+    uint32_t descriptionOffset;
+    uint32_t descriptionLength;
+    uint32_t dueDateOffset;
+    uint32_t dueDateLength;
+};
+
+struct StoreIndexEntry {
+    int32_t id;
+    uint32_t record;
+};
+
+static_assert(sizeof(StoreHeader) == 72, "StoreHeader layout changed");
+static_assert(sizeof(StoreRecord) == 48, "StoreRecord layout changed");
+static_assert(sizeof(StoreIndexEntry) == 8, "StoreIndexEntry layout changed");
+
+// Read-only memory mapping of a V2 store. Opening validates the header and
+// section bounds once; after that records are read in place with no parsing.
+// A block-compressed store (see BlockFile) is decoded into memory instead.
+class MappedStore {
+private:
+    const char* data;
+    size_t length;
+    std::vector<char> inflated; // decoded bytes when the file is compressed
+    const StoreHeader* header;
+    const StoreRecord* records;
+    const char* heap;
+    const StoreIndexEntry* index;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    bool validate();
+    bool openCompressed(const std::string& path);
+
+public:
+    static const char MAGIC[16];
+    static const uint32_t VERSION = 2;
+
+    MappedStore();
+    ~MappedStore();
+
+    MappedStore(const MappedStore&) = delete;
+    MappedStore& operator=(const MappedStore&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    bool isCompressed() const { return !inflated.empty(); }
+
+    // True if the file at path is a V2 store, plain or block-compressed
+    static bool isV2File(const std::string& path);
+
+    size_t size() const { return header ? static_cast<size_t>(header->count) : 0; }
+    std::time_t savedAt() const { return header ? static_cast<std::time_t>(header->savedAt) : 0; }
+    const StoreRecord& record(size_t i) const { return records[i]; }
+    std::string_view string(uint32_t offset, uint32_t length) const {
+        return std::string_view(heap + offset, length);
+    }
+
+    // Bytes after the footer index (used by backups for removed ids)
+    std::string_view trailer() const;
+
+    // Binary search over the footer index; returns -1 when absent
+    long findById(int id) const;
+
+    // Zero-copy view of record i; valid until close()
+    TodoItemView view(size_t i) const;
+
+    // Build an owning TodoItem from record i
+    TodoItem materialize(size_t i) const;
+};
+
+#endif // MAPPEDSTORE_H
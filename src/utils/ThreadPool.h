@@ -0,0 +1,54 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads shared by the bulk paths (import, parallel
+// sorts). Tasks must not throw.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop();
+    void enqueue(std::function<void()> task);
+
+public:
+    // 0 = one thread per hardware core
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename Task>
+    std::future<void> submit(Task task) {
+        auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+        std::future<void> done = packaged->get_future();
+        enqueue([packaged] { (*packaged)(); });
+        return done;
+    }
+
+    // Run body(i) for every i in [0, count) and wait. The calling thread
+    // takes indices too, so nested calls from a worker cannot deadlock,
+    // and runs other queued tasks while it waits.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // Process-wide pool sized to the hardware
+    static ThreadPool& shared();
+};
+
+#endif // THREADPOOL_H
@@ -65,7 +65,7 @@ void DisplayManager::showTodoDetails(int id) {
     }
 }
 
-void DisplayManager::showSearchResults(const std::vector<TodoItem*>& results) {
+void DisplayManager::showSearchResults(const std::vector<TodoHandle>& results) {
     if (results.empty()) {
         std::cout << ColorManager::YELLOW << "No results found!" << ColorManager::RESET << std::endl;
         return;
@@ -75,15 +75,19 @@ void DisplayManager::showSearchResults(const std::vector<TodoItem*>& results) {
     std::cout << ColorManager::UNDERLINE << ColorManager::CYAN;
     std::cout << std::setw(5) << "ID" << " | "
               << std::setw(20) << "Title" << " | "
+              << std::setw(10) << "Due Date" << " | "
               << std::setw(12) << "Priority" << " | "
               << std::setw(12) << "Status" << ColorManager::RESET << std::endl;
     
-    std::cout << std::string(55, '-') << std::endl;
+    std::cout << std::string(68, '-') << std::endl;
     
-    for (const auto& todo : results) {
+    for (TodoHandle handle : results) {
+        // Handles of todos deleted since the search resolve to nullptr
+        const TodoItem* todo = controller.resolve(handle);
         if (todo) {
             std::cout << std::setw(5) << todo->id << " | "
                       << std::setw(20) << (todo->title.length() > 20 ? todo->title.substr(0, 17) + "..." : todo->title) << " | "
+                      << std::setw(10) << todo->dueDate << " | "
                       << std::setw(12) << ColorManager::colorPriority(static_cast<int>(todo->priority)) << " | "
                       << std::setw(12) << ColorManager::colorStatus(todo->statusToString()) << std::endl;
         }
@@ -96,9 +100,9 @@ void DisplayManager::showStatistics() {
     
     std::cout << ColorManager::CYAN << "\n=== Todo Statistics ===\n" << ColorManager::RESET;
     
-    // Use controller's methods (includes demo + manual data)
-    auto todos = controller.getAllTodos();
-    int total = todos.size();
+    // O(1) reads from the controller's aggregates, whatever the store size
+    const Aggregates& stats = controller.getAggregates();
+    int total = static_cast<int>(stats.total());
     int completed = controller.getCompletedCount();
     int pending = controller.getPendingCount();
     int inProgress = controller.getInProgressCount();
@@ -109,15 +113,40 @@ void DisplayManager::showStatistics() {
     std::cout << "Pending: " << pending << std::endl;
     
     if (total > 0) {
-        int completionRate = (completed * 100) / total;
+        int completionRate = static_cast<int>((static_cast<long long>(completed) * 100) / total);
         std::cout << "\nCompletion Rate: ";
         ColorManager::printProgressBar(completionRate);
     }
-    
+
+    // Open = pending + in progress, split by due bucket
+    const DueBucket buckets[] = {DueBucket::OVERDUE, DueBucket::TODAY, DueBucket::THIS_WEEK,
+                                 DueBucket::LATER, DueBucket::NO_DATE};
+    std::cout << ColorManager::CYAN << "\n=== Open Todos by Priority ===\n" << ColorManager::RESET;
+    std::cout << std::left << std::setw(8) << "Priority" << " | " << std::setw(5) << "Open";
+    for (DueBucket bucket : buckets) {
+        std::cout << " | " << std::setw(9) << Aggregates::bucketName(bucket);
+    }
+    std::cout << std::endl << std::string(80, '-') << std::endl;
+    for (Priority priority : {Priority::URGENT, Priority::HIGH, Priority::MEDIUM, Priority::LOW}) {
+        std::cout << std::setw(8) << TodoItem::priorityName(priority) << " | "
+                  << std::setw(5) << controller.countByPriorityAndStatus(priority, Status::COMPLETED, true);
+        for (DueBucket bucket : buckets) {
+            size_t open = stats.count(priority, Status::PENDING, bucket) +
+                          stats.count(priority, Status::IN_PROGRESS, bucket);
+            std::cout << " | " << std::setw(9) << open;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::right;
+
+    const size_t MAX_LISTED_IDS = 20;
     std::cout << ColorManager::CYAN << "\n=== Todo IDs Summary ===\n" << ColorManager::RESET;
     std::cout << "Available IDs: ";
-    for (const auto& todo : todos) {
-        std::cout << todo.id << " ";
+    for (int id : controller.getIds(MAX_LISTED_IDS)) {
+        std::cout << id << " ";
+    }
+    if (stats.total() > MAX_LISTED_IDS) {
+        std::cout << "... and " << stats.total() - MAX_LISTED_IDS << " more";
     }
     std::cout << std::endl;
     
@@ -388,13 +417,13 @@ void DisplayManager::showAlgorithmsDemo() {
     std::cout << "   - Best/Average Case: O(n log n)\n";
     std::cout << "   - Worst Case: O(n²)\n";
     std::cout << "   - Space: O(log n)\n";
-    std::cout << "   - Used for: Sorting by priority\n";
+    std::cout << "   - Used for: Comparison sorts on any field\n";
     std::cout << "   - Type: Divide and conquer, in-place\n";
     
     std::cout << "\n" << ColorManager::CYAN << "2. Merge Sort (O(n log n)):\n" << ColorManager::RESET;
     std::cout << "   - Time Complexity: O(n log n) always\n";
     std::cout << "   - Space Complexity: O(n)\n";
-    std::cout << "   - Used for: Sorting by due date\n";
+    std::cout << "   - Used for: Stable comparison sorts\n";
     std::cout << "   - Type: Stable, not in-place\n";
     
     std::cout << "\n" << ColorManager::CYAN << "3. Heap Sort (O(n log n)):\n" << ColorManager::RESET;
@@ -409,8 +438,26 @@ void DisplayManager::showAlgorithmsDemo() {
     std::cout << "   - Used for: Educational purposes, small datasets\n";
     std::cout << "   - Type: Simple, stable, in-place\n";
     
+    std::cout << "\n" << ColorManager::CYAN << "5. Counting Sort (O(n + k)):\n" << ColorManager::RESET;
+    std::cout << "   - Time Complexity: O(n + k) for k distinct keys\n";
+    std::cout << "   - Space Complexity: O(n + k)\n";
+    std::cout << "   - Used for: Sorting by priority and status\n";
+    std::cout << "   - Type: Stable, not in-place, no comparisons\n";
+    
+    std::cout << "\n" << ColorManager::CYAN << "6. Radix Sort (O(n)):\n" << ColorManager::RESET;
+    std::cout << "   - Time Complexity: O(n) for 32-bit keys (3 passes of 11 bits)\n";
+    std::cout << "   - Space Complexity: O(n)\n";
+    std::cout << "   - Used for: Sorting by id and parsed due day\n";
+    std::cout << "   - Type: Stable, least significant digit first\n";
+    
+    std::cout << "\n" << ColorManager::CYAN << "7. Parallel Quick / Merge / Heap Sort (O(n log n / p)):\n" << ColorManager::RESET;
+    std::cout << "   - Time Complexity: O(n log n) work split over p threads\n";
+    std::cout << "   - Space Complexity: O(n), one scratch buffer\n";
+    std::cout << "   - Used for: Sorting millions of todos on the shared thread pool\n";
+    std::cout << "   - Type: Task-parallel recursion, merges split by co-ranking\n";
+    
     std::cout << ColorManager::GREEN << "\n=== DATA STRUCTURES USED ===\n" << ColorManager::RESET;
-    std::cout << "1. " << ColorManager::YELLOW << "Priority Queue (Binary Heap):\n" << ColorManager::RESET;
+    std::cout << "1. " << ColorManager::YELLOW << "Priority Queue (4-ary Heap):\n" << ColorManager::RESET;
     std::cout << "   - Insertion: O(log n)\n";
     std::cout << "   - Extraction: O(log n)\n";
     std::cout << "   - Peek: O(1)\n";
@@ -469,6 +516,18 @@ void DisplayManager::showAlgorithmsDemo() {
               << std::setw(15) << "O(n²)" 
               << std::setw(15) << "O(n²)" 
               << std::setw(15) << "O(1)" << std::endl;
+    
+    std::cout << std::setw(20) << "Counting Sort" 
+              << std::setw(15) << "O(n + k)" 
+              << std::setw(15) << "O(n + k)" 
+              << std::setw(15) << "O(n + k)" 
+              << std::setw(15) << "O(n + k)" << std::endl;
+    
+    std::cout << std::setw(20) << "Radix Sort" 
+              << std::setw(15) << "O(n)" 
+              << std::setw(15) << "O(n)" 
+              << std::setw(15) << "O(n)" 
+              << std::setw(15) << "O(n)" << std::endl;
 }
 
 void DisplayManager::clearInputBuffer() {
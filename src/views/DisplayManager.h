@@ -17,7 +17,7 @@ public:
     void showMainMenu();
     void showAllTodos();
     void showTodoDetails(int id);
-    void showSearchResults(const std::vector<TodoItem*>& results);
+    void showSearchResults(const std::vector<TodoHandle>& results);
     void showStatistics();
     
     // Input methods
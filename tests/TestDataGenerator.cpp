@@ -1,8 +1,30 @@
 #include "TestDataGenerator.h"
+#include "../src/utils/Journal.h"
+#include "../src/utils/FileHandler.h"
+#include "../src/utils/MappedStore.h"
+#include "../src/utils/BlockFile.h"
+#include "../src/utils/CsvWriter.h"
+#include "../src/utils/JsonWriter.h"
+#include "../src/utils/Importer.h"
+#include "../src/models/TrigramIndex.h"
+#include "../src/models/TitleTrie.h"
+#include "../src/models/BucketQueue.h"
+#include "../src/models/TopKCache.h"
+#include "../src/models/PriorityQueue.h"
+#include "../src/models/DueDateIndex.h"
+#include "../src/algorithms/SortSearch.h"
+#include "../src/algorithms/SubstringSearch.h"
+#include <fstream>
 #include <iostream>
+#include <iomanip>
 #include <chrono>
 #include <random>
+#include <thread>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <climits>
 #include <ctime>
 
 void TestDataGenerator::generateSampleData(TodoController& controller, int count) {
@@ -61,12 +83,15 @@ void TestDataGenerator::runPerformanceTests(TodoController& controller) {
     for (int size : sizes) {
         std::cout << "\nTesting with " << size << " items:\n";
         
+        size_t syncsBefore = controller.getSyncCount();
         auto start = std::chrono::high_resolution_clock::now();
         generateSampleData(controller, size);
+        controller.waitForDurability();
         auto end = std::chrono::high_resolution_clock::now();
         
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
         std::cout << "Generation time: " << duration.count() << "ms\n";
+        std::cout << "Group commits (fsync): " << controller.getSyncCount() - syncsBefore << "\n";
         
         // Test sorting performance
         start = std::chrono::high_resolution_clock::now();
@@ -108,6 +133,8 @@ void TestDataGenerator::testSortAlgorithms() {
     std::cout << "Merge Sort      | O(n log n)| O(n log n)| O(n log n)| O(n)\n";
     std::cout << "Heap Sort       | O(n log n)| O(n log n)| O(n log n)| O(1)\n";
     std::cout << "Bubble Sort     | O(n)      | O(n²)     | O(n²)     | O(1)\n";
+    std::cout << "Counting Sort   | O(n + k)  | O(n + k)  | O(n + k)  | O(n + k)\n";
+    std::cout << "Radix Sort      | O(n)      | O(n)      | O(n)      | O(n)\n";
 }
 
 void TestDataGenerator::testFileOperations() {
@@ -119,6 +146,1067 @@ void TestDataGenerator::testFileOperations() {
     std::cout << "4. Backup System: Automatic versioning\n";
 }
 
+int TestDataGenerator::testNextTasks(TodoController& controller) {
+    std::cout << "\n=== NEXT TASKS TEST ===\n";
+    
+    const size_t large = 2 * TopKCache::MAX_CAPACITY + 1;
+    size_t open = controller.getTotalCount() - controller.getCompletedCount();
+    if (open < large) {
+        // A third of the sample todos come out completed
+        generateSampleData(controller, static_cast<int>((large - open) * 3 / 2 + 100));
+        open = controller.getTotalCount() - controller.getCompletedCount();
+    }
+    
+    // nextTasks' order: open first, then priority, due day (none last), slot
+    auto urgent = [](const TodoItem& a, const TodoItem& b) {
+        bool aDone = a.status == Status::COMPLETED;
+        bool bDone = b.status == Status::COMPLETED;
+        if (aDone != bDone) return bDone;
+        if (a.priority != b.priority) return a.priority > b.priority;
+        int32_t aDay = DueDateIndex::parseDay(a.dueDate);
+        int32_t bDay = DueDateIndex::parseDay(b.dueDate);
+        if ((aDay == DueDateIndex::NO_DATE) != (bDay == DueDateIndex::NO_DATE)) {
+            return bDay == DueDateIndex::NO_DATE;
+        }
+        return aDay < bDay;
+    };
+    
+    int failures = 0;
+    for (size_t k : {size_t(10), TopKCache::MAX_CAPACITY, TopKCache::MAX_CAPACITY + 1, large}) {
+        std::vector<TodoHandle> expected = controller.topK(k, urgent);
+        expected.resize(std::min(k, open));
+        // Twice: the first read may refill the cache, the second reads it
+        for (int pass = 0; pass < 2; pass++) {
+            std::vector<TodoHandle> got = controller.nextTasks(k);
+            bool same = got == expected;
+            std::cout << "nextTasks(" << k << ") pass " << pass + 1 << ": " << got.size() << " rows"
+                      << (same ? "" : "  (DIFFERS FROM topK)") << "\n";
+            if (!same) failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+void TestDataGenerator::benchmarkJournalWrites() {
+    std::cout << "\n=== JOURNAL WRITE BENCHMARK ===\n";
+    std::cout << "Each mutation appends one record, so cost should not grow with the store.\n\n";
+    std::cout << std::setw(12) << "Store Size" << " | "
+              << std::setw(14) << "Avg Write (us)" << " | "
+              << std::setw(12) << "Bytes/Write" << "\n";
+    std::cout << std::string(44, '-') << "\n";
+    
+    const char* journalFile = "bench_journal.tmp";
+    const int writes = 1000;
+    int sizes[] = {1000, 10000, 100000, 1000000};
+    std::mt19937 rng(42);
+    
+    for (int size : sizes) {
+        std::vector<TodoItem> store = generateTestItems(size);
+        std::uniform_int_distribution<int> pick(0, size - 1);
+        
+        Journal journal(journalFile);
+        journal.reset();
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < writes; i++) {
+            TodoItem& item = store[pick(rng)];
+            item.updatedAt = std::time(nullptr);
+            if (i % 2 == 0) {
+                journal.appendUpsert(item);
+            } else {
+                journal.appendStatus(item.id, Status::COMPLETED, item.updatedAt);
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        double totalUs = std::chrono::duration<double, std::micro>(end - start).count();
+        std::cout << std::setw(12) << size << " | "
+                  << std::setw(14) << std::fixed << std::setprecision(2) << totalUs / writes << " | "
+                  << std::setw(12) << journal.sizeInBytes() / writes << "\n";
+    }
+    
+    std::remove(journalFile);
+}
+
+void TestDataGenerator::benchmarkColdStart(int count) {
+    std::cout << "\n=== COLD START BENCHMARK (TODO_DATA_V2) ===\n";
+    
+    const char* storeFile = "bench_store.tmp";
+    {
+        PriorityQueue queue(generateTestItems(count));
+        FileHandler handler(storeFile);
+        handler.saveToFile(queue);
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    MappedStore store;
+    bool opened = store.open(storeFile);
+    auto end = std::chrono::high_resolution_clock::now();
+    double openMs = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    if (!opened) {
+        std::cout << "Could not map " << storeFile << "\n";
+        std::remove(storeFile);
+        return;
+    }
+    
+    start = std::chrono::high_resolution_clock::now();
+    size_t found = 0;
+    for (int i = 0; i < 100000; i++) {
+        if (store.findById(rand() % count + 1) >= 0) found++;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double lookupMs = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    // Materialize first so both passes see a warm page cache
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<TodoItem> items;
+    items.reserve(store.size());
+    for (size_t i = 0; i < store.size(); i++) {
+        items.push_back(store.materialize(i));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double materializeMs = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<TodoItemView> views;
+    views.reserve(store.size());
+    for (size_t i = 0; i < store.size(); i++) {
+        views.push_back(store.view(i));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double viewMs = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    std::cout << "Items:                     " << store.size() << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Map + validate:            " << openMs << "ms\n";
+    std::cout << "100000 id lookups:         " << lookupMs << "ms (" << found << " found)\n";
+    std::cout << "Materialize all TodoItems: " << materializeMs << "ms\n";
+    std::cout << "Build all TodoItemViews:   " << viewMs << "ms\n";
+    
+    store.close();
+    std::remove(storeFile);
+}
+
+int TestDataGenerator::benchmarkCompression(int count) {
+    std::cout << "\n=== BLOCK COMPRESSION BENCHMARK (" << count << " items) ===\n";
+    
+    const char* storeFile = "bench_store.tmp";
+    const char* blockFile = "bench_store_z.tmp";
+    {
+        PriorityQueue queue(generateTestItems(count));
+        FileHandler handler(storeFile);
+        handler.saveToFile(queue);
+    }
+    
+    std::ifstream in(storeFile, std::ios::binary | std::ios::ate);
+    std::string raw(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(&raw[0], raw.size());
+    in.close();
+    double rawMB = raw.size() / (1024.0 * 1024.0);
+    
+    struct Config { uint32_t blockSize; bool dictionary; };
+    const Config configs[] = {
+        {16 * 1024, false}, {16 * 1024, true},
+        {64 * 1024, false}, {64 * 1024, true},
+        {256 * 1024, true}
+    };
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Raw store: " << rawMB << " MB\n\n";
+    std::cout << std::left << std::setw(8) << "Block" << std::setw(7) << "Dict"
+              << std::right << std::setw(9) << "Ratio" << std::setw(12) << "Write MB/s"
+              << std::setw(12) << "Load MB/s" << std::setw(14) << "1 block (us)" << "\n";
+    
+    int failures = 0;
+    for (const auto& config : configs) {
+        auto start = std::chrono::high_resolution_clock::now();
+        BlockFile::write(blockFile, raw.data(), raw.size(), config.blockSize, config.dictionary);
+        auto end = std::chrono::high_resolution_clock::now();
+        double writeSec = std::chrono::duration<double>(end - start).count();
+        
+        std::ifstream sized(blockFile, std::ios::binary | std::ios::ate);
+        double ratio = raw.size() / static_cast<double>(sized.tellg());
+        sized.close();
+        
+        // Full load: decode every block and validate the store
+        start = std::chrono::high_resolution_clock::now();
+        MappedStore store;
+        bool opened = store.open(blockFile);
+        end = std::chrono::high_resolution_clock::now();
+        double loadSec = std::chrono::duration<double>(end - start).count();
+        if (!opened || store.size() != static_cast<size_t>(count)) {
+            std::cout << "Could not load " << blockFile << "\n";
+            failures++;
+            break;
+        }
+        store.close();
+        
+        // Random access: one block at a time through the index
+        BlockFile blocks;
+        blocks.open(blockFile);
+        std::string block;
+        const int reads = 1000;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < reads; i++) {
+            blocks.readBlock(rand() % blocks.blockCount(), block);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        double blockUs = std::chrono::duration<double, std::micro>(end - start).count() / reads;
+        
+        std::cout << std::left << std::setw(8) << (std::to_string(config.blockSize / 1024) + "K")
+                  << std::setw(7) << (config.dictionary ? "yes" : "no")
+                  << std::right << std::setw(8) << ratio << "x"
+                  << std::setw(12) << rawMB / writeSec
+                  << std::setw(12) << rawMB / loadSec
+                  << std::setw(14) << blockUs << "\n";
+    }
+    
+    std::remove(blockFile);
+    std::remove(storeFile);
+    return failures == 0 ? 0 : 1;
+}
+
+void TestDataGenerator::benchmarkCsvExport(int rows) {
+    std::cout << "\n=== CSV EXPORT BENCHMARK (" << rows << " rows) ===\n";
+    
+    // Cycle over a smaller pool so 10M rows fit in memory; one title in
+    // eight carries a comma or quote to exercise the escaping path
+    int distinct = std::min(rows, 1000000);
+    std::vector<TodoItem> items = generateTestItems(distinct);
+    for (int i = 0; i < distinct; i += 8) {
+        items[i].title += (i % 16 == 0) ? ", part 2" : " \"draft\"";
+    }
+    const char* csvFile = "bench_export.tmp";
+    
+    // Same columns as FileHandler::exportToCSV
+    auto start = std::chrono::high_resolution_clock::now();
+    CsvWriter csv;
+    csv.open(csvFile);
+    for (int i = 0; i < rows; i++) {
+        const TodoItem& item = items[i % distinct];
+        csv.field(static_cast<int64_t>(item.id));
+        csv.field(item.title);
+        csv.field(item.description);
+        csv.field(item.dueDate);
+        csv.field(TodoItem::priorityName(item.priority));
+        csv.field(TodoItem::statusName(item.status));
+        csv.field(static_cast<int64_t>(item.createdAt));
+        csv.field(static_cast<int64_t>(item.updatedAt));
+        csv.endRow();
+    }
+    csv.close();
+    auto end = std::chrono::high_resolution_clock::now();
+    double writerSec = std::chrono::duration<double>(end - start).count();
+    
+    std::ifstream sized(csvFile, std::ios::binary | std::ios::ate);
+    double megabytes = sized.tellg() / (1024.0 * 1024.0);
+    sized.close();
+    
+    // The previous exporter: field by field through ofstream <<
+    int streamRows = std::min(rows, 1000000);
+    start = std::chrono::high_resolution_clock::now();
+    {
+        std::ofstream out(csvFile);
+        for (int i = 0; i < streamRows; i++) {
+            const TodoItem& item = items[i % distinct];
+            out << item.id << ","
+                << "\"" << item.title << "\","
+                << "\"" << item.description << "\","
+                << item.dueDate << ","
+                << item.priorityToString() << ","
+                << item.statusToString() << ","
+                << item.createdAt << ","
+                << item.updatedAt << "\n";
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double streamSec = std::chrono::duration<double>(end - start).count();
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "CsvWriter:        " << writerSec * 1000 << "ms, " << megabytes << " MB, "
+              << megabytes / writerSec << " MB/s, " << rows / writerSec / 1e6 << "M rows/s\n";
+    std::cout << "ofstream (" << streamRows << "): " << streamSec * 1000 << "ms, "
+              << streamRows / streamSec / 1e6 << "M rows/s\n";
+    
+    std::remove(csvFile);
+}
+
+void TestDataGenerator::benchmarkJsonExport(int rows) {
+    std::cout << "\n=== NDJSON EXPORT BENCHMARK (" << rows << " rows) ===\n";
+    
+    int distinct = std::min(rows, 1000000);
+    std::vector<TodoItem> items = generateTestItems(distinct);
+    for (int i = 0; i < distinct; i += 8) {
+        items[i].description += (i % 16 == 0) ? "\nsee \"notes\"" : " C:\\path";
+    }
+    const char* jsonFile = "bench_export.tmp";
+    
+    // Formatting cost per escape kernel (same layout as exportToNDJSON)
+    JsonWriter::Kernel best = JsonWriter::activeKernel();
+    double megabytes = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (JsonWriter::Kernel kernel : {JsonWriter::Kernel::SCALAR, JsonWriter::Kernel::SSE2,
+                                      JsonWriter::Kernel::AVX2}) {
+        if (!JsonWriter::useKernel(kernel)) continue;
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        JsonWriter json;
+        json.open(jsonFile);
+        for (int i = 0; i < rows; i++) {
+            const TodoItem& item = items[i % distinct];
+            json.raw("{\"id\":");
+            json.number(item.id);
+            json.raw(",\"title\":");
+            json.string(item.title);
+            json.raw(",\"description\":");
+            json.string(item.description);
+            json.raw(",\"dueDate\":");
+            json.string(item.dueDate);
+            json.raw(",\"priority\":");
+            json.string(TodoItem::priorityName(item.priority));
+            json.raw(",\"status\":");
+            json.string(TodoItem::statusName(item.status));
+            json.raw(",\"createdAt\":");
+            json.number(static_cast<int64_t>(item.createdAt));
+            json.raw(",\"updatedAt\":");
+            json.number(static_cast<int64_t>(item.updatedAt));
+            json.raw("}\n");
+        }
+        json.close();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        
+        std::ifstream sized(jsonFile, std::ios::binary | std::ios::ate);
+        megabytes = sized.tellg() / (1024.0 * 1024.0);
+        std::cout << std::left << std::setw(8) << JsonWriter::kernelName(kernel) << std::right
+                  << seconds * 1000 << "ms, " << megabytes / seconds << " MB/s\n";
+    }
+    JsonWriter::useKernel(best);
+    
+    // I/O floor: the same number of bytes written with no formatting
+    std::vector<char> block(JsonWriter::BUFFER_SIZE, 'x');
+    size_t total = static_cast<size_t>(megabytes * 1024 * 1024);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::FILE* out = std::fopen(jsonFile, "wb");
+    for (size_t written = 0; out && written < total; written += block.size()) {
+        std::fwrite(block.data(), 1, std::min(block.size(), total - written), out);
+    }
+    if (out) std::fclose(out);
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "raw I/O " << seconds * 1000 << "ms, " << megabytes / seconds << " MB/s ("
+              << megabytes << " MB)\n";
+    
+    std::remove(jsonFile);
+}
+
+int TestDataGenerator::benchmarkImport(int rows) {
+    std::cout << "\n=== PARALLEL IMPORT BENCHMARK (" << rows << " rows) ===\n";
+    
+    const char* csvFile = "bench_import_csv.tmp";
+    const char* jsonFile = "bench_import_ndjson.tmp";
+    {
+        // Both files in the exporters' layouts, cycling over a smaller pool
+        int distinct = std::min(rows, 1000000);
+        std::vector<TodoItem> items = generateTestItems(distinct);
+        for (int i = 0; i < distinct; i += 8) {
+            items[i].description += "\nwith \"quotes\", commas";
+        }
+        
+        CsvWriter csv;
+        JsonWriter json;
+        csv.open(csvFile);
+        json.open(jsonFile);
+        for (const char* column : {"ID", "Title", "Description", "Due Date",
+                                   "Priority", "Status", "Created At", "Updated At"}) {
+            csv.field(column);
+        }
+        csv.endRow();
+        for (int i = 0; i < rows; i++) {
+            const TodoItem& item = items[i % distinct];
+            csv.field(static_cast<int64_t>(i + 1));
+            csv.field(item.title);
+            csv.field(item.description);
+            csv.field(item.dueDate);
+            csv.field(TodoItem::priorityName(item.priority));
+            csv.field(TodoItem::statusName(item.status));
+            csv.field(static_cast<int64_t>(item.createdAt));
+            csv.field(static_cast<int64_t>(item.updatedAt));
+            csv.endRow();
+            
+            json.raw("{\"id\":");
+            json.number(i + 1);
+            json.raw(",\"title\":");
+            json.string(item.title);
+            json.raw(",\"description\":");
+            json.string(item.description);
+            json.raw(",\"dueDate\":");
+            json.string(item.dueDate);
+            json.raw(",\"priority\":");
+            json.string(TodoItem::priorityName(item.priority));
+            json.raw(",\"status\":");
+            json.string(TodoItem::statusName(item.status));
+            json.raw(",\"createdAt\":");
+            json.number(static_cast<int64_t>(item.createdAt));
+            json.raw(",\"updatedAt\":");
+            json.number(static_cast<int64_t>(item.updatedAt));
+            json.raw("}\n");
+        }
+        csv.close();
+        json.close();
+    }
+    
+    std::vector<size_t> threadCounts;
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads < hardware; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardware);
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(8) << "Format" << std::right << std::setw(9) << "Threads"
+              << std::setw(12) << "Time (ms)" << std::setw(12) << "MB/s" << std::setw(10) << "Speedup\n";
+    
+    int failures = 0;
+    for (const char* file : {csvFile, jsonFile}) {
+        std::ifstream sized(file, std::ios::binary | std::ios::ate);
+        double megabytes = sized.tellg() / (1024.0 * 1024.0);
+        sized.close();
+        
+        double baseline = 0;
+        for (size_t threads : threadCounts) {
+            ThreadPool pool(threads);
+            std::vector<TodoItem> imported;
+            ImportStats stats;
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            bool ok = Importer::importFile(file, imported, stats, ImportFormat::AUTO, pool);
+            auto end = std::chrono::high_resolution_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            if (baseline == 0) baseline = seconds;
+            
+            if (!ok || imported.size() != static_cast<size_t>(rows) || stats.skipped > 0) {
+                std::cout << "Import of " << file << " returned " << imported.size() << " rows\n";
+                failures++;
+            }
+            std::cout << std::left << std::setw(8) << Importer::formatName(stats.format)
+                      << std::right << std::setw(9) << threads
+                      << std::setw(12) << seconds * 1000
+                      << std::setw(12) << megabytes / seconds
+                      << std::setw(9) << baseline / seconds << "x\n";
+        }
+    }
+    
+    std::remove(csvFile);
+    std::remove(jsonFile);
+    return failures == 0 ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkSubstringSearch(int count) {
+    std::cout << "\n=== SUBSTRING SEARCH BENCHMARK (" << count << " items) ===\n";
+    
+    std::vector<TodoItem> items = generateTicketItems(count);
+    
+    TrigramIndex index;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < items.size(); i++) {
+        index.insert(static_cast<uint32_t>(i), items[i].title);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Index build: " << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms, " << index.trigramCount() << " trigrams, "
+              << index.memoryUsage() / (1024.0 * 1024.0) << " MB\n\n";
+    
+    std::string rare = "TK-" + std::to_string(count / 2 + 7);
+    const std::string patterns[] = {"Review", "Meeting", "TK-12345", rare, "ee"};
+    
+    std::cout << std::left << std::setw(12) << "Pattern" << std::right << std::setw(10) << "Matches"
+              << std::setw(14) << "Candidates" << std::setw(12) << "Scan (ms)"
+              << std::setw(13) << "Index (ms)" << std::setw(10) << "Speedup\n";
+    
+    int failures = 0;
+    for (const std::string& pattern : patterns) {
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<int> scanned = SortSearch::searchByTitle(items, pattern);
+        end = std::chrono::high_resolution_clock::now();
+        double scanMs = std::chrono::duration<double, std::milli>(end - start).count();
+        
+        // Candidates from the index, verified with find; short patterns
+        // cannot be narrowed and fall back to the scan
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<int> found;
+        RoaringBitmap slots;
+        size_t candidates = items.size();
+        if (index.candidates(pattern, slots)) {
+            candidates = slots.cardinality();
+            slots.forEach([&](uint32_t slot) {
+                if (items[slot].title.find(pattern) != std::string::npos) {
+                    found.push_back(static_cast<int>(slot));
+                }
+                return true;
+            });
+        } else {
+            found = SortSearch::searchByTitle(items, pattern);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        double indexMs = std::chrono::duration<double, std::milli>(end - start).count();
+        
+        if (found != scanned) {
+            std::cout << "Index and scan disagree on \"" << pattern << "\"\n";
+            failures++;
+        }
+        std::cout << std::left << std::setw(12) << pattern << std::right << std::setw(10) << found.size()
+                  << std::setw(14) << candidates << std::setw(12) << scanMs
+                  << std::setw(13) << indexMs << std::setw(9) << scanMs / indexMs << "x\n";
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkSubstringScan(int count) {
+    std::cout << "\n=== SUBSTRING SCAN BENCHMARK (" << count << " items) ===\n";
+    
+    std::vector<TodoItem> items = generateTicketItems(count);
+    TextArena titles;
+    for (const auto& item : items) titles.add(item.title);
+    double arenaMB = titles.byteCount() / (1024.0 * 1024.0);
+    
+    // memchr for an absent byte reads the arena at close to memory speed;
+    // the volatile byte keeps the calls from being folded into one
+    const int rounds = 5;
+    volatile char probe = 0x7F;
+    auto start = std::chrono::high_resolution_clock::now();
+    bool absent = true;
+    for (int r = 0; r < rounds; r++) {
+        absent &= std::memchr(titles.data(), probe, titles.byteCount()) == nullptr;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Arena: " << arenaMB << " MB";
+    if (absent) {
+        std::cout << "; memchr reads it at "
+                  << arenaMB * rounds / std::chrono::duration<double>(end - start).count() << " MB/s";
+    }
+    std::cout << "\n\n";
+    
+    struct Case { std::string pattern; bool ignoreCase; };
+    const Case cases[] = {
+        {"TK-" + std::to_string(count / 2 + 7), false}, {"Review", false},
+        {"review", true}, {"ee", false}, {"tk-12345", true}
+    };
+    const SubstringSearch::Kernel kernels[] = {
+        SubstringSearch::Kernel::SCALAR, SubstringSearch::Kernel::SSE2, SubstringSearch::Kernel::AVX2
+    };
+    SubstringSearch::Kernel original = SubstringSearch::activeKernel();
+    
+    std::cout << std::left << std::setw(12) << "Pattern" << std::setw(6) << "Case"
+              << std::setw(8) << "Kernel" << std::right << std::setw(10) << "Matches"
+              << std::setw(11) << "Time (ms)" << std::setw(10) << "MB/s"
+              << std::setw(14) << "vs find()\n";
+    
+    int failures = 0;
+    for (const Case& test : cases) {
+        // Baseline: one find per item, as SortSearch::searchByTitle does
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<uint32_t> expected;
+        for (size_t i = 0; i < items.size(); i++) {
+            const std::string& title = items[i].title;
+            bool hit = test.ignoreCase
+                ? std::search(title.begin(), title.end(), test.pattern.begin(), test.pattern.end(),
+                              [](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); }) != title.end()
+                : title.find(test.pattern) != std::string::npos;
+            if (hit) expected.push_back(static_cast<uint32_t>(i));
+        }
+        end = std::chrono::high_resolution_clock::now();
+        double baseMs = std::chrono::duration<double, std::milli>(end - start).count();
+        std::cout << std::left << std::setw(12) << test.pattern << std::setw(6)
+                  << (test.ignoreCase ? "any" : "exact") << std::setw(8) << "find()"
+                  << std::right << std::setw(10) << expected.size() << std::setw(11) << baseMs
+                  << std::setw(10) << arenaMB / (baseMs / 1000) << std::setw(13) << "1.00x\n";
+        
+        for (SubstringSearch::Kernel kernel : kernels) {
+            if (!SubstringSearch::useKernel(kernel)) continue;
+            start = std::chrono::high_resolution_clock::now();
+            std::vector<uint32_t> rows = titles.search(test.pattern, test.ignoreCase);
+            end = std::chrono::high_resolution_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            if (rows != expected) {
+                std::cout << "Kernel disagrees with find() on \"" << test.pattern << "\"\n";
+                failures++;
+            }
+            std::cout << std::left << std::setw(12) << test.pattern << std::setw(6)
+                      << (test.ignoreCase ? "any" : "exact") << std::setw(8)
+                      << SubstringSearch::kernelName(kernel) << std::right << std::setw(10) << rows.size()
+                      << std::setw(11) << ms << std::setw(10) << arenaMB / (ms / 1000)
+                      << std::setw(12) << baseMs / ms << "x\n";
+        }
+    }
+    SubstringSearch::useKernel(original);
+    return failures == 0 ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkAutocomplete(int count) {
+    std::cout << "\n=== TITLE AUTOCOMPLETE BENCHMARK (" << count << " items) ===\n";
+    
+    // Ticket numbers make most titles distinct, like real ones; the stock
+    // titles still give some prefixes hundreds of thousands of completions
+    std::vector<TodoItem> items = generateTicketItems(count);
+    std::vector<int32_t> dueDays(items.size());
+    for (size_t i = 0; i < items.size(); i++) dueDays[i] = DueDateIndex::parseDay(items[i].dueDate);
+    
+    TitleTrie trie;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < items.size(); i++) {
+        trie.insert(static_cast<uint32_t>(i), items[i].title, items[i].priority, dueDays[i]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Build: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms, "
+              << trie.nodeCount() << " nodes, " << trie.memoryUsage() / (1024.0 * 1024.0) << " MB\n\n";
+    
+    // Prefixes as typed: every length of a random title's first 12 bytes
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, items.size() - 1);
+    std::vector<std::string> prefixes;
+    for (int i = 0; i < 2000; i++) {
+        const std::string& title = items[pick(rng)].title;
+        for (size_t length = 1; length <= std::min<size_t>(12, title.size()); length++) {
+            prefixes.push_back(title.substr(0, length));
+        }
+    }
+    
+    std::cout << std::left << std::setw(6) << "k" << std::right << std::setw(12) << "Lookups"
+              << std::setw(12) << "Mean (us)" << std::setw(12) << "p99 (us)" << std::setw(12) << "Max (us)\n";
+    for (size_t k : {1, 10, 50}) {
+        std::vector<double> micros;
+        micros.reserve(prefixes.size());
+        size_t returned = 0;
+        for (const std::string& prefix : prefixes) {
+            start = std::chrono::high_resolution_clock::now();
+            returned += trie.complete(prefix, k).size();
+            end = std::chrono::high_resolution_clock::now();
+            micros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        std::sort(micros.begin(), micros.end());
+        double mean = 0;
+        for (double us : micros) mean += us;
+        mean /= micros.size();
+        std::cout << std::left << std::setw(6) << k << std::right << std::setw(12) << micros.size()
+                  << std::setw(12) << mean << std::setw(12) << micros[micros.size() * 99 / 100]
+                  << std::setw(11) << micros.back() << (returned == 0 ? " (no results)" : "") << "\n";
+    }
+    
+    // Spot check one prefix against a full sort of its matches
+    std::string prefix = "team meeting tk-1";
+    std::vector<std::pair<std::tuple<int, int32_t, uint32_t>, uint32_t>> expected;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (TitleTrie::normalize(items[i].title).compare(0, prefix.size(), prefix) == 0) {
+            int32_t day = dueDays[i] == DueDateIndex::NO_DATE ? INT32_MAX : dueDays[i];
+            expected.push_back({{3 - static_cast<int>(items[i].priority), day, static_cast<uint32_t>(i)},
+                                static_cast<uint32_t>(i)});
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<uint32_t> top = trie.complete(prefix, 10);
+    bool agrees = top.size() == std::min<size_t>(10, expected.size());
+    for (size_t i = 0; agrees && i < top.size(); i++) agrees = top[i] == expected[i].second;
+    std::cout << "\nTop 10 for \"" << prefix << "\" " << (agrees ? "match" : "DIFFER FROM")
+              << " a full sort of " << expected.size() << " matches\n";
+    
+    // Incremental maintenance: retitle and re-rank random todos
+    const int edits = 100000;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < edits; i++) {
+        uint32_t slot = static_cast<uint32_t>(pick(rng));
+        trie.remove(slot);
+        trie.insert(slot, "Edited " + items[slot].title, randomPriority(), dueDays[slot]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Remove + insert: "
+              << std::chrono::duration<double, std::micro>(end - start).count() / edits << " us per edit\n";
+    return agrees ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkBucketQueue(int operations, int held) {
+    std::cout << "\n=== BUCKET QUEUE BENCHMARK (" << operations << " operations, " << held
+              << " held) ===\n";
+    
+    // Hold model: fill the queue, then alternate pop and push so its size
+    // stays put; both queues see the same pushes
+    std::vector<TodoItem> items = generateTestItems(held);
+    std::vector<int32_t> dueDays(items.size());
+    for (size_t i = 0; i < items.size(); i++) dueDays[i] = DueDateIndex::parseDay(items[i].dueDate);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, items.size() - 1);
+    std::vector<uint32_t> pushes(operations / 2);
+    for (uint32_t& slot : pushes) slot = static_cast<uint32_t>(pick(rng));
+    auto handleOf = [](uint32_t slot) { return TodoHandle{slot, 1}; };
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(16) << "Queue" << std::right << std::setw(12) << "Fill (ms)"
+              << std::setw(12) << "Ops (ms)" << std::setw(12) << "ns / op\n";
+    auto report = [&](const char* name, double fillMs, double opsMs) {
+        std::cout << std::left << std::setw(16) << name << std::right << std::setw(12) << fillMs
+                  << std::setw(12) << opsMs << std::setw(11) << opsMs * 1e6 / operations << "\n";
+    };
+    
+    {
+        PriorityQueue queue;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const TodoItem& item : items) queue.push(item);
+        auto filled = std::chrono::high_resolution_clock::now();
+        for (uint32_t slot : pushes) {
+            queue.pop();
+            queue.push(items[slot]);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        report("PriorityQueue", std::chrono::duration<double, std::milli>(filled - start).count(),
+               std::chrono::duration<double, std::milli>(end - filled).count());
+    }
+    
+    BucketQueue queue;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < items.size(); i++) {
+        queue.push(handleOf(static_cast<uint32_t>(i)), items[i].priority, dueDays[i]);
+    }
+    auto filled = std::chrono::high_resolution_clock::now();
+    for (uint32_t slot : pushes) {
+        queue.pop();
+        queue.push(handleOf(slot), items[slot].priority, dueDays[slot]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    report("BucketQueue", std::chrono::duration<double, std::milli>(filled - start).count(),
+           std::chrono::duration<double, std::milli>(end - filled).count());
+    
+    // Drain and check the order: priority descending, then due day, with
+    // no due date last
+    auto rank = [&](uint32_t slot) {
+        int32_t day = dueDays[slot] == DueDateIndex::NO_DATE ? INT32_MAX : dueDays[slot];
+        return std::make_pair(3 - static_cast<int>(items[slot].priority), day);
+    };
+    size_t drained = 0;
+    bool ordered = true;
+    std::pair<int, int32_t> previous(INT_MIN, INT32_MIN);
+    while (!queue.isEmpty()) {
+        std::pair<int, int32_t> current = rank(queue.pop().slot);
+        ordered = ordered && !(current < previous);
+        previous = current;
+        drained++;
+    }
+    std::cout << "\nDrained " << drained << " handles " << (ordered ? "in order" : "OUT OF ORDER") << "\n";
+    return ordered ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkHeapUpdates(int count, int updates) {
+    std::cout << "\n=== PRIORITY QUEUE UPDATE BENCHMARK (" << count << " items, " << updates
+              << " changes) ===\n";
+    
+    std::vector<TodoItem> items = generateTestItems(count);
+    PriorityQueue queue(items);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pickId(1, count);
+    std::cout << std::fixed << std::setprecision(2);
+    
+    // The old way: edit the copy, then rebuild the whole heap
+    const int rebuilds = 20;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rebuilds; i++) {
+        TodoItem* todo = queue.linearSearch(pickId(rng));
+        if (todo) todo->priority = randomPriority();
+        queue.pushAll(queue.release());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double rebuildUs = std::chrono::duration<double, std::micro>(end - start).count() / rebuilds;
+    std::cout << "Linear search + rebuild: " << rebuildUs << " us per change\n";
+    
+    // Priority and due date changes, re-sifted in place
+    std::vector<std::string> dates;
+    for (int day = -10; day < 50; day++) dates.push_back(randomDate(day));
+    queue.find(1); // builds the position index outside the timing
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < updates; i++) {
+        int id = pickId(rng);
+        TodoItem* todo = queue.find(id);
+        if (i % 2) {
+            todo->priority = static_cast<Priority>(rng() % 4);
+        } else {
+            todo->dueDate = dates[rng() % dates.size()];
+        }
+        queue.update(id);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double updateUs = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+    std::cout << "find + update(id):       " << updateUs << " us per change ("
+              << rebuildUs / updateUs << "x faster)\n";
+    
+    // Erase half the ids, then drain and check the heap order held
+    start = std::chrono::high_resolution_clock::now();
+    size_t erased = 0;
+    for (int id = 1; id <= count; id += 2) {
+        if (queue.erase(id)) erased++;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "erase(id):               "
+              << std::chrono::duration<double, std::micro>(end - start).count() / erased << " us each\n";
+    
+    bool ordered = queue.size() == items.size() - erased;
+    bool first = true;
+    TodoItem previous;
+    while (!queue.isEmpty()) {
+        TodoItem item = queue.pop();
+        if (!first && previous < item) ordered = false;
+        if (item.id % 2 == 1) ordered = false;
+        previous = std::move(item);
+        first = false;
+    }
+    std::cout << "\nDrained the rest " << (ordered ? "in heap order" : "OUT OF ORDER") << "\n";
+    return ordered ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkTopK(int count, int k) {
+    std::cout << "\n=== TOP-K BENCHMARK (" << count << " items, k = " << k << ") ===\n";
+    
+    PriorityQueue queue(generateShortItems(count, 60));
+    const std::vector<TodoItem>& all = queue.items();
+    auto first = [](const TodoItem& a, const TodoItem& b) { return a < b; };
+    size_t n = all.size();
+    std::cout << std::fixed << std::setprecision(3);
+    
+    auto byIndex = [&](uint32_t a, uint32_t b) { return all[a] < all[b]; };
+    
+    // What sortByPriority does: sort a permutation of everything
+    std::vector<uint32_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = static_cast<uint32_t>(i);
+    double sortMs = timeMs([&] { std::sort(order.begin(), order.end(), byIndex); });
+    std::vector<TodoItem> expected;
+    for (int i = 0; i < k && i < static_cast<int>(n); i++) expected.push_back(all[order[i]]);
+    
+    for (size_t i = 0; i < n; i++) order[i] = static_cast<uint32_t>(i);
+    double nthMs = timeMs([&] {
+        size_t kk = std::min<size_t>(k, n);
+        std::nth_element(order.begin(), order.begin() + kk, order.end(), byIndex);
+        std::sort(order.begin(), order.begin() + kk, byIndex);
+    });
+    std::vector<uint32_t>().swap(order);
+    
+    std::vector<TodoItem> best;
+    double topKMs = timeMs([&] { best = queue.topK(k, first); });
+    std::vector<TodoItem> nextPops;
+    double topMs = timeMs([&] { nextPops = queue.top(k); });
+    
+    // Ties are common, so compare ranks rather than ids
+    bool agrees = best.size() == expected.size();
+    for (size_t i = 0; agrees && i < best.size(); i++) {
+        agrees = !(best[i] < expected[i]) && !(expected[i] < best[i]);
+    }
+    
+    std::cout << std::left << std::setw(34) << "Method" << std::right << std::setw(12) << "Time (ms)\n";
+    std::cout << std::left << std::setw(34) << "Full sort of a permutation" << std::right << std::setw(11)
+              << sortMs << "\n";
+    std::cout << std::left << std::setw(34) << "nth_element + sort of k" << std::right << std::setw(11)
+              << nthMs << "\n";
+    std::cout << std::left << std::setw(34) << "PriorityQueue::topK (bounded heap)" << std::right
+              << std::setw(11) << topKMs << (agrees ? "" : "  (DIFFERS FROM SORT)") << "\n";
+    std::cout << std::left << std::setw(34) << "PriorityQueue::top (next pops)" << std::right
+              << std::setw(11) << topMs << "\n";
+    
+    // The controller's cache under a stream of edits: every edit drops the
+    // row and offers it again with a new priority
+    TopKCache cache;
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = TopKCache::urgencyKey(static_cast<uint32_t>(i), all[i].priority,
+                                        DueDateIndex::parseDay(all[i].dueDate));
+    }
+    auto refill = [&] {
+        std::vector<uint64_t> smallest(keys);
+        size_t kk = std::min(cache.limit(), n);
+        std::nth_element(smallest.begin(), smallest.begin() + kk, smallest.end());
+        std::sort(smallest.begin(), smallest.begin() + kk);
+        std::vector<TopKCache::Row> rows;
+        for (size_t i = 0; i < kk; i++) rows.push_back({smallest[i], static_cast<uint32_t>(smallest[i])});
+        cache.assign(std::move(rows), kk == n);
+    };
+    refill();
+    
+    const int edits = 1000000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(n - 1));
+    size_t refills = 0;
+    double editMs = timeMs([&] {
+        for (int i = 0; i < edits; i++) {
+            uint32_t slot = pick(rng);
+            cache.remove(slot);
+            Priority priority = static_cast<Priority>(rng() % 4);
+            keys[slot] = TopKCache::urgencyKey(slot, priority, DueDateIndex::parseDay(all[slot].dueDate));
+            cache.offer(slot, keys[slot]);
+            if (!cache.covers(k)) {
+                refill();
+                refills++;
+            }
+        }
+    });
+    std::cout << "\nCache: " << edits << " edits in " << std::setprecision(1) << editMs
+              << " ms (" << std::setprecision(3) << editMs * 1000.0 / edits << " us each), " << refills
+              << " refill(s)\n";
+    return agrees ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkLinearSorts(int count) {
+    std::cout << "\n=== LINEAR SORT BENCHMARK (" << count << " items) ===\n";
+    
+    // Shuffled so ids are unsorted
+    std::vector<TodoItem> items = generateShortItems(count, 400);
+    std::mt19937 rng(42);
+    std::shuffle(items.begin(), items.end(), rng);
+    
+    auto identity = [&] {
+        std::vector<uint32_t> order(items.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+        return order;
+    };
+    
+    // Both sides are stable, so they must produce the same permutation
+    struct Case {
+        const char* name;
+        bool (*compare)(const TodoItem&, const TodoItem&);
+        std::vector<uint32_t> (*linear)(const std::vector<TodoItem>&);
+    };
+    const Case cases[] = {
+        {"Priority", SortSearch::compareByPriority, SortSearch::orderByPriority},
+        {"Status", SortSearch::compareByStatus, SortSearch::orderByStatus},
+        {"Due date", SortSearch::compareByDueDate, SortSearch::orderByDueDate},
+        {"Id", SortSearch::compareById, SortSearch::orderById},
+    };
+    
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(10) << "Key" << std::right << std::setw(18) << "stable_sort (ms)"
+              << std::setw(14) << "Linear (ms)" << std::setw(10) << "Speedup\n";
+    int failures = 0;
+    for (const Case& c : cases) {
+        std::vector<uint32_t> expected = identity();
+        double compareMs = timeMs([&] {
+            std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) {
+                return c.compare(items[a], items[b]);
+            });
+        });
+        std::vector<uint32_t> order;
+        double linearMs = timeMs([&] { order = c.linear(items); });
+        std::cout << std::left << std::setw(10) << c.name << std::right << std::setw(17) << compareMs
+                  << std::setw(14) << linearMs << std::setw(9) << compareMs / linearMs << "x"
+                  << (order == expected ? "" : "  (DIFFERENT ORDER)") << "\n";
+        if (order != expected) failures++;
+    }
+    
+    // The sort it replaces, on a sample small enough to finish
+    std::vector<TodoItem> sample(items.begin(), items.begin() + std::min<size_t>(20000, items.size()));
+    std::vector<TodoItem> bubbled = sample;
+    double bubbleMs = timeMs([&] { SortSearch::bubbleSort(bubbled); });
+    double countingMs = timeMs([&] { SortSearch::applyOrder(sample, SortSearch::orderByStatus(sample)); });
+    std::cout << "\nBy status, " << sample.size() << " items: bubble sort " << bubbleMs
+              << " ms, counting sort + one move per item " << countingMs << " ms\n";
+    return failures == 0 ? 0 : 1;
+}
+
+int TestDataGenerator::benchmarkParallelSorts(int count) {
+    std::cout << "\n=== PARALLEL SORT BENCHMARK (" << count << " items) ===\n";
+    
+    // A run holds three copies (input, sorted copy, scratch buffer)
+    std::vector<TodoItem> items = generateShortItems(count, 400);
+    
+    auto ids = [](const std::vector<TodoItem>& sorted) {
+        std::vector<int> result;
+        result.reserve(sorted.size());
+        for (const TodoItem& item : sorted) result.push_back(item.id);
+        return result;
+    };
+    
+    std::vector<size_t> threadCounts;
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads < hardware; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardware);
+    
+    // The parallel merge sort is stable, so it must match std::stable_sort
+    // (the sequential merge takes the right run on ties); the other two are
+    // checked for sortedness. quickSort has no baseline row: its Lomuto
+    // partition is quadratic on the four repeated priorities
+    struct Case {
+        const char* name;
+        void (*sequential)(std::vector<TodoItem>&);
+        void (*parallel)(std::vector<TodoItem>&, ThreadPool&);
+        bool (*before)(const TodoItem&, const TodoItem&);
+        bool stable;
+    };
+    const Case cases[] = {
+        {"Quick", nullptr, SortSearch::parallelQuickSort, SortSearch::compareByPriority, false},
+        {"Merge", [](std::vector<TodoItem>& v) { SortSearch::mergeSort(v, 0, static_cast<int>(v.size()) - 1); },
+         SortSearch::parallelMergeSort, SortSearch::compareByDueDate, true},
+        {"Heap", SortSearch::heapSort, SortSearch::parallelHeapSort,
+         [](const TodoItem& a, const TodoItem& b) { return SortSearch::compareByPriority(b, a); }, false},
+    };
+    
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(8) << "Sort" << std::right << std::setw(12) << "Threads"
+              << std::setw(12) << "Time (ms)" << std::setw(10) << "Speedup\n";
+    int failures = 0;
+    for (const Case& c : cases) {
+        std::vector<int> expected;
+        if (c.stable) {
+            std::vector<TodoItem> sorted = items;
+            std::stable_sort(sorted.begin(), sorted.end(), c.before);
+            expected = ids(sorted);
+        }
+        if (c.sequential) {
+            std::vector<TodoItem> sorted = items;
+            double ms = timeMs([&] { c.sequential(sorted); });
+            std::cout << std::left << std::setw(8) << c.name << std::right << std::setw(12) << "sequential"
+                      << std::setw(12) << ms << "\n";
+        }
+        
+        double baseline = 0;
+        for (size_t threads : threadCounts) {
+            ThreadPool pool(threads);
+            std::vector<TodoItem> sorted = items;
+            double ms = timeMs([&] { c.parallel(sorted, pool); });
+            if (baseline == 0) baseline = ms;
+            
+            bool ok = sorted.size() == items.size() &&
+                      std::is_sorted(sorted.begin(), sorted.end(), c.before) &&
+                      (!c.stable || ids(sorted) == expected);
+            std::cout << std::left << std::setw(8) << c.name << std::right << std::setw(12) << threads
+                      << std::setw(12) << ms << std::setw(9) << baseline / ms << "x"
+                      << (ok ? "" : "  (NOT SORTED)") << "\n";
+            if (!ok) failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+std::vector<TodoItem> TestDataGenerator::generateTicketItems(int count) {
+    std::vector<TodoItem> items = generateTestItems(count);
+    for (auto& item : items) {
+        item.title += " TK-" + std::to_string(item.id);
+    }
+    return items;
+}
+
+std::vector<TodoItem> TestDataGenerator::generateShortItems(int count, int days) {
+    std::vector<std::string> dates;
+    for (int day = 0; day < days; day++) dates.push_back(randomDate(day));
+    std::mt19937 rng(42);
+    std::vector<TodoItem> items;
+    items.reserve(count);
+    for (int i = 0; i < count; i++) {
+        items.emplace_back(i + 1, "Task", "", dates[rng() % dates.size()], static_cast<Priority>(rng() % 4));
+        items.back().status = static_cast<Status>(rng() % 3);
+    }
+    return items;
+}
+
 std::string TestDataGenerator::randomTitle() {
     std::vector<std::string> titles = {
         "Complete Project", "Team Meeting", "Buy Groceries",
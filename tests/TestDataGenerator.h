@@ -2,6 +2,7 @@
 #define TESTDATAGENERATOR_H
 
 #include "../src/controllers/TodoController.h"
+#include <chrono>
 #include <vector>
 #include <string>
 
@@ -13,12 +14,49 @@ public:
     static void testSearchAlgorithms();
     static void testSortAlgorithms();
     static void testFileOperations();
+    // nextTasks against a topK over every todo, for k below and above the
+    // cache's capacity; adds sample todos if there are too few. 0 = pass
+    static int testNextTasks(TodoController& controller);
+    static void benchmarkJournalWrites();
+    static void benchmarkColdStart(int count = 1000000);
+    static void benchmarkCsvExport(int rows = 10000000);
+    static void benchmarkJsonExport(int rows = 10000000);
+    // These also check their results against a simple baseline: 0 = pass
+    static int benchmarkCompression(int count = 1000000);
+    static int benchmarkImport(int rows = 10000000);
+    static int benchmarkSubstringSearch(int count = 1000000);
+    static int benchmarkSubstringScan(int count = 1000000);
+    static int benchmarkAutocomplete(int count = 1000000);
+    static int benchmarkBucketQueue(int operations = 10000000, int held = 1000000);
+    static int benchmarkHeapUpdates(int count = 1000000, int updates = 5000000);
+    static int benchmarkTopK(int count = 10000000, int k = 10);
+    static int benchmarkLinearSorts(int count = 10000000);
+    static int benchmarkParallelSorts(int count = 50000000);
     
 private:
     static std::string randomTitle();
     static std::string randomDescription();
     static std::string randomDate(int daysFromNow);
     static Priority randomPriority();
+    
+    // Test items with " TK-<id>" appended to each title, so patterns range
+    // from very common down to a single match
+    static std::vector<TodoItem> generateTicketItems(int count);
+    // Items with short fields, so tens of millions fit in memory: title
+    // "Task", no description, due dates from a pool of days (some empty)
+    // because formatting one per item dominates setup
+    static std::vector<TodoItem> generateShortItems(int count, int days);
+    // Wall time of fn() in milliseconds
+    template <typename Fn>
+    static double timeMs(Fn fn);
 };
 
+template <typename Fn>
+double TestDataGenerator::timeMs(Fn fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
 #endif // TESTDATAGENERATOR_H
\ No newline at end of file